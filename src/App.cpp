@@ -0,0 +1,317 @@
+/**
+ * Pomodoro App Implementation
+ * Loop logic moved here from main.cpp so it also runs on the host
+ */
+
+#include "App.h"
+#include "Profiler.h"
+#include "Trace.h"
+
+PomodoroApp* PomodoroApp::instance = nullptr;
+
+PomodoroApp::PomodoroApp()
+    : currentState(STATE_IDLE),
+      completedPomodoros(0),
+      settingsMenuIndex(0),
+      settingsEditing(false),
+      statsSummary(),
+      needsRedraw(true),
+      pendingEdgeUs(0),
+      published(),
+      publishedVersion(0),
+      lastArcPublishMs(0),
+      drawnVersion(0),
+      renderWake(nullptr),
+      storageQueued(false),
+      storageWake(nullptr),
+      frame(),
+      lastRedrawTime(0),
+      renderStatsReset(false),
+      loopCount(0),
+      redrawCount(0),
+      skippedFrames(0),
+      inputLatency(),
+      tickLatency() {
+    settings.workDuration = 25 * 60;           // 25 minutes
+    settings.shortBreakDuration = 5 * 60;      // 5 minutes
+    settings.longBreakDuration = 25 * 60;      // 25 minutes
+    settings.pomodorosUntilLongBreak = 4;
+    settings.brightnessLevel = 3;              // Mid brightness (level 3 of 6)
+    settings.themeIndex = 0;                   // Classic
+}
+
+void PomodoroApp::begin() {
+    instance = this;
+
+    // Settings from the last power cycle (defaults if none were ever saved)
+    settingsStore.load(settings);
+
+    hal.display->setBrightness((settings.brightnessLevel * 255) / 6);
+    display.setTheme(settings.themeIndex);
+    hal.display->panel().fillScreen(display.getTheme().states[STATE_IDLE].background);
+
+    // Allocate the off-screen back buffer and decode icons (falls back to direct drawing)
+    display.begin();
+
+    // Initialize input handler
+    inputHandler.init();
+
+    // Completed sessions go to the flash log; the statistics are rebuilt from it
+    history.begin();
+    stats.rebuild(history);
+    timerManager.setSessionCompleteCallback(onSessionComplete);
+
+    // Draw initial screen
+    needsRedraw = true;
+    resetTimer();
+
+    // Pick up a session interrupted by a reset or power loss
+    SessionSnapshot session;
+    uint32_t downtimeMs;
+    if (checkpoint.begin(session, downtimeMs)) {
+        timerManager.restoreSession(session, downtimeMs, currentState);
+        completedPomodoros = session.completedPomodoros;
+    }
+}
+
+uint32_t PomodoroApp::step() {
+    uint32_t sleepMs = stepControl();
+    stepStorage();
+    return min(sleepMs, stepRender());
+}
+
+uint32_t PomodoroApp::stepControl() {
+    PROFILE_SCOPE(PHASE_CONTROL);
+    uint32_t edgeUs = pendingEdgeUs;
+    {
+        PROFILE_SCOPE(PHASE_INPUT_UPDATE);
+        hal.input->update();
+    }
+    loopCount++;
+
+    // Get current timer values for input handler
+    uint32_t timerRemaining = timerManager.getRemaining();
+    uint32_t timerDuration = timerManager.getDuration();
+
+    // Store old state to detect reset
+    TimerState oldState = currentState;
+
+    // Handle all input (encoder, button, touch) through InputHandler
+    {
+        PROFILE_SCOPE(PHASE_PROCESS_INPUT);
+        inputHandler.processInput(currentState, settings, settingsMenuIndex, settingsEditing,
+                                  timerRemaining, timerDuration, needsRedraw,
+                                  startTimer, pauseTimer, resumeTimer, resetTimer);
+    }
+
+    // Button edge -> state change latency (edges that changed nothing are dropped)
+    if (edgeUs != 0) {
+        if (currentState != oldState) inputLatency.record(micros() - edgeUs);
+        if (pendingEdgeUs == edgeUs) pendingEdgeUs = 0;
+    }
+
+    // The statistics screen shows the figures as of when it was opened
+    if (currentState == STATE_STATS && oldState != STATE_STATS) {
+        stats.summarize(hal.clock->wallSeconds(), statsSummary);
+    }
+
+    // Persist dial and menu changes once they settle (coalesced in SettingsStore)
+    settingsStore.update(settings);
+    settingsStore.service();
+
+    // Only sync back if we're in IDLE state (encoder adjustments)
+    // If reset happened (state changed to IDLE), re-read values instead
+    if (currentState == STATE_IDLE && oldState == STATE_IDLE) {
+        // Dial was adjusted in idle - sync changes back
+        timerManager.setRemaining(timerRemaining);
+        timerManager.setDuration(timerDuration);
+    }
+
+    // Update timer logic (including buzzer)
+    {
+        PROFILE_SCOPE(PHASE_TIMER_UPDATE);
+        timerManager.update(currentState, settings, completedPomodoros, needsRedraw);
+    }
+
+    // Keep a resumable copy of the session (RTC memory each second, flash journal on changes)
+    {
+        PROFILE_SCOPE(PHASE_CHECKPOINT);
+        SessionSnapshot session;
+        timerManager.saveSession(currentState, session);
+        session.completedPomodoros = completedPomodoros;
+        if (checkpoint.update(session)) storageQueued = true;
+    }
+
+    // Flash writes (journal, finished sessions) happen in stepStorage()
+    if (storageQueued) {
+        storageQueued = false;
+        if (storageWake) storageWake();
+    }
+
+    // Hand anything visible that changed to the renderer
+    publish();
+
+    // Next thing that needs the loop: a second boundary or beep step, the
+    // long-press threshold, the input poll window, a settings commit or an arc
+    // step. UINT32_MAX = nothing until an input interrupt wakes the loop.
+    uint32_t sleepMs = timerManager.getMsUntilNextEvent(currentState);
+    sleepMs = min(sleepMs, inputHandler.getMsUntilNextEvent());
+    sleepMs = min(sleepMs, settingsStore.getMsUntilCommit());
+    sleepMs = min(sleepMs, getMsUntilArcStep());
+    return sleepMs;
+}
+
+bool PomodoroApp::isCounting() const {
+    return currentState == STATE_RUNNING || currentState == STATE_SHORT_BREAK ||
+           currentState == STATE_LONG_BREAK;
+}
+
+uint16_t PomodoroApp::getArcStep() const {
+    if (!SHOW_PROGRESS_ARC || currentState == STATE_IDLE) return 0;
+    uint64_t durationUs = (uint64_t)timerManager.getDuration() * 1000000ULL;
+    if (durationUs == 0) return 0;
+    uint64_t step = timerManager.getElapsedUs() * PROGRESS_ARC_STEPS / durationUs;
+    return step > PROGRESS_ARC_STEPS ? PROGRESS_ARC_STEPS : (uint16_t)step;
+}
+
+uint32_t PomodoroApp::getMsUntilArcStep() const {
+    if (!SHOW_PROGRESS_ARC || !isCounting() || published.arcStep >= PROGRESS_ARC_STEPS) return UINT32_MAX;
+
+    // Elapsed time at which the arc reaches its next step
+    uint64_t durationUs = (uint64_t)timerManager.getDuration() * 1000000ULL;
+    uint64_t dueUs = (durationUs * (published.arcStep + 1) + PROGRESS_ARC_STEPS - 1) / PROGRESS_ARC_STEPS;
+    uint64_t elapsedUs = timerManager.getElapsedUs();
+    uint32_t ms = dueUs > elapsedUs ? (uint32_t)((dueUs - elapsedUs + 999) / 1000) : 0;
+
+    // No sooner than the frame cap allows
+    uint32_t sinceFrame = millis() - lastArcPublishMs;
+    if (sinceFrame < PROGRESS_ARC_FRAME_MS) ms = max(ms, PROGRESS_ARC_FRAME_MS - sinceFrame);
+    return ms;
+}
+
+void PomodoroApp::publish() {
+    uint32_t remaining = timerManager.getRemaining();
+    bool stateChanged = currentState != published.state;
+    bool remainingChanged = remaining != published.remaining;
+
+    // The arc moves on its own at most every PROGRESS_ARC_FRAME_MS; any other
+    // change carries its latest step along
+    uint32_t now = millis();
+    uint16_t arcStep = getArcStep();
+    bool arcDue = arcStep != published.arcStep && now - lastArcPublishMs >= PROGRESS_ARC_FRAME_MS;
+    if (!needsRedraw && !stateChanged && !remainingChanged && !arcDue &&
+        completedPomodoros == published.completedPomodoros) {
+        return; // Nothing visible changed
+    }
+    if (arcStep != published.arcStep) lastArcPublishMs = now;
+
+    // A countdown second rolled over: remember when, for the tick -> pixels latency
+    published.tickUs = 0;
+    if (isCounting() && remainingChanged && !stateChanged) {
+        uint32_t intoSecondUs = (uint32_t)(timerManager.getElapsedUs() % 1000000ULL);
+        published.tickUs = micros() - intoSecondUs;
+        if (published.tickUs == 0) published.tickUs = 1;
+    }
+
+    published.state = currentState;
+    published.remaining = remaining;
+    published.duration = timerManager.getDuration();
+    published.arcStep = arcStep;
+    published.completedPomodoros = completedPomodoros;
+    published.settings = settings;
+    published.settingsMenuIndex = settingsMenuIndex;
+    published.settingsEditing = settingsEditing;
+    published.stats = statsSummary;
+    published.version = ++publishedVersion;
+    snapshots.publish(published);
+    needsRedraw = false;
+
+    if (renderWake) renderWake();
+}
+
+void PomodoroApp::stepStorage() {
+    PROFILE_SCOPE(PHASE_STORAGE);
+    checkpoint.service();
+    history.service();
+}
+
+uint32_t PomodoroApp::stepRender() {
+    // Render counters are only ever written here, so they are reset here too
+    if (__atomic_exchange_n(&renderStatsReset, false, __ATOMIC_ACQ_REL)) {
+        redrawCount = 0;
+        skippedFrames = 0;
+        tickLatency = LatencyStats();
+        display.resetStats();
+    }
+
+    snapshots.read(frame);
+    if (frame.version == drawnVersion) return UINT32_MAX; // Already on screen
+
+    // Performance optimization: Frame rate limiting
+    uint32_t now = millis();
+    uint32_t sinceRedraw = now - lastRedrawTime;
+    if (sinceRedraw < MIN_REDRAW_INTERVAL_MS) {
+        skippedFrames++;
+        return MIN_REDRAW_INTERVAL_MS - sinceRedraw;
+    }
+
+    lastRedrawTime = now;
+    redrawCount++;
+    redraw();
+    __atomic_store_n(&drawnVersion, frame.version, __ATOMIC_RELEASE);
+    if (frame.tickUs != 0) tickLatency.record(micros() - frame.tickUs);
+    return UINT32_MAX;
+}
+
+void PomodoroApp::resetStats() {
+    loopCount = 0;
+    inputLatency = LatencyStats();
+    __atomic_store_n(&renderStatsReset, true, __ATOMIC_RELEASE);
+    if (renderWake) renderWake();
+}
+
+void PomodoroApp::redraw() {
+    // Draws `frame` only: control-side state may be changing on the other core
+    TRACE(TRACE_REDRAW_BEGIN, frame.state, 0);
+    display.setTheme(frame.settings.themeIndex);    // No-op unless it was just changed
+
+    // Widgets of the current screen repaint only what differs from the last frame
+    display.render(frame);
+
+    // Push the changed region to the panel in one transfer
+    {
+        PROFILE_SCOPE(PHASE_FLUSH);
+        display.flush();
+    }
+    TRACE(TRACE_REDRAW_END, frame.state, display.getBytesPushed());
+}
+
+// Callback wrappers for InputHandler to call TimerManager
+void PomodoroApp::startTimer(uint32_t duration) {
+    instance->timerManager.start(duration, instance->currentState);
+}
+
+void PomodoroApp::pauseTimer() {
+    // A press while the alarm is sounding silences it instead of pausing
+    if (instance->timerManager.isAlarmActive()) {
+        instance->timerManager.silenceAlarm();
+        return;
+    }
+    instance->timerManager.pause(instance->currentState);
+}
+
+void PomodoroApp::resumeTimer() {
+    instance->timerManager.resume(instance->currentState);
+}
+
+void PomodoroApp::resetTimer() {
+    instance->timerManager.reset(instance->currentState, instance->settings);
+}
+
+void PomodoroApp::onSessionComplete(TimerState finished, uint32_t duration) {
+    // One wall clock read serves both the log and the statistics
+    HistoryEntry entry = SessionHistory::stamp(finished, duration);
+    if (!instance->history.post(entry)) Serial.println("History: queue full - session not logged");
+    instance->stats.record(entry);
+    instance->storageQueued = true;
+}
@@ -0,0 +1,152 @@
+/**
+ * Pomodoro App
+ * The timer's loop body (input -> timer -> redraw), shared by the device
+ * build (main.cpp) and the host build (hal/host). Control and rendering
+ * only meet in a published snapshot, so they can run as separate tasks.
+ */
+
+#ifndef APP_H
+#define APP_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "types.h"
+#include "hal/Hal.h"
+#include "Display.h"
+#include "FocusStats.h"
+#include "InputHandler.h"
+#include "TimerManager.h"
+#include "SessionCheckpoint.h"
+#include "SessionHistory.h"
+#include "SettingsStore.h"
+#include "SnapshotChannel.h"
+
+// Latency samples (for performance monitoring)
+struct LatencyStats {
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+
+    void record(uint32_t us) { count++; totalUs += us; if (us > maxUs) maxUs = us; }
+    uint32_t averageUs() const { return count ? (uint32_t)(totalUs / count) : 0; }
+};
+
+class PomodoroApp {
+public:
+    // Constructor
+    PomodoroApp();
+
+    // Initialize modules and draw the first screen (call after the HAL is installed)
+    void begin();
+
+    // Run one loop iteration (control, storage, then render); returns milliseconds
+    // until the loop has work again
+    uint32_t step();
+
+    // The parts of step(), for running them as separate tasks:
+    // input, timer and alarm -> snapshot; returns ms until control has work again
+    // (UINT32_MAX = only an input interrupt)
+    uint32_t stepControl();
+    // snapshot -> pixels; returns ms until a throttled redraw is due (UINT32_MAX = idle)
+    uint32_t stepRender();
+    // Called after each publish so a separate render task can be woken (nullptr = none)
+    void setRenderWake(void (*wake)()) { renderWake = wake; }
+    // queued journal and history appends -> flash (slow: may erase a sector)
+    void stepStorage();
+    // Called when control queues a flash write, to wake a separate storage task
+    void setStorageWake(void (*wake)()) { storageWake = wake; }
+    // True until queued flash writes are done
+    bool isStoragePending() const { return checkpoint.isJournalPending() || history.isPending(); }
+
+    // Timestamp of the latest button/encoder edge (micros(), safe from an ISR)
+    void noteInputEdge(uint32_t us) { pendingEdgeUs = us ? us : 1; }
+
+    // State access
+    TimerState getState() const { return currentState; }
+    uint8_t getSettingsMenuIndex() const { return settingsMenuIndex; }
+    bool isSettingsEditing() const { return settingsEditing; }
+    const PomodoroSettings& getSettings() const { return settings; }
+    uint8_t getCompletedPomodoros() const { return completedPomodoros; }
+    // True until the renderer has drawn the latest published content
+    bool isRedrawPending() const { return __atomic_load_n(&drawnVersion, __ATOMIC_ACQUIRE) != publishedVersion; }
+
+    // Modules
+    Display& getDisplay() { return display; }
+    InputHandler& getInputHandler() { return inputHandler; }
+    TimerManager& getTimerManager() { return timerManager; }
+    SettingsStore& getSettingsStore() { return settingsStore; }
+    SessionCheckpoint& getCheckpoint() { return checkpoint; }
+    SessionHistory& getHistory() { return history; }
+    FocusStats& getStats() { return stats; }
+
+    // Loop statistics (for performance monitoring)
+    uint32_t getLoopCount() const { return loopCount; }
+    uint32_t getRedrawCount() const { return redrawCount; }
+    uint32_t getSkippedFrames() const { return skippedFrames; }
+    const LatencyStats& getInputLatency() const { return inputLatency; }  // Edge -> state change
+    const LatencyStats& getTickLatency() const { return tickLatency; }    // Second boundary -> pixels
+    // Clears the control counters now; the renderer clears its own (redraws, skipped
+    // frames, tick latency and the Display's) at the start of its next step
+    void resetStats();
+
+private:
+    // Application state (control side)
+    TimerState currentState;
+    PomodoroSettings settings;
+    uint8_t completedPomodoros;
+    uint8_t settingsMenuIndex;
+    bool settingsEditing;
+    StatsSummary statsSummary;       // Figures for the statistics screen, taken when it opens
+    bool needsRedraw;
+    volatile uint32_t pendingEdgeUs;
+
+    // Control -> render hand-off
+    SnapshotChannel<DisplaySnapshot> snapshots;
+    DisplaySnapshot published;       // Last published content (control side copy)
+    uint32_t publishedVersion;
+    uint32_t lastArcPublishMs;       // When the arc last moved (caps it at PROGRESS_ARC_FRAME_MS)
+    uint32_t drawnVersion;           // Written by the renderer once a version is on screen
+    void (*renderWake)();
+    bool storageQueued;              // A flash write was queued this step
+    void (*storageWake)();
+
+    // Render side
+    DisplaySnapshot frame;           // Content being drawn
+    uint32_t lastRedrawTime;
+    bool renderStatsReset;           // Set by resetStats(), cleared by the renderer
+
+    // Module instances
+    Display display;
+    InputHandler inputHandler;
+    TimerManager timerManager;
+    SettingsStore settingsStore;
+    SessionCheckpoint checkpoint;
+    SessionHistory history;
+    FocusStats stats;
+
+    // Loop statistics
+    uint32_t loopCount;
+    uint32_t redrawCount;
+    uint32_t skippedFrames;
+    LatencyStats inputLatency;
+    LatencyStats tickLatency;
+
+    void publish();
+    void redraw();
+
+    // Progress arc: current step, and ms until it next moves (UINT32_MAX = not moving)
+    bool isCounting() const;
+    uint16_t getArcStep() const;
+    uint32_t getMsUntilArcStep() const;
+
+    // Callback wrappers for InputHandler (plain function pointers can't bind an instance)
+    static PomodoroApp* instance;
+    static void startTimer(uint32_t duration);
+    static void pauseTimer();
+    static void resumeTimer();
+    static void resetTimer();
+    // TimerManager callback
+    static void onSessionComplete(TimerState finished, uint32_t duration);
+};
+
+#endif // APP_H
@@ -1,327 +1,231 @@
 /**
  * Display Module Implementation
- * All drawing functions moved here from main.cpp
- * UI/visuals remain exactly the same
+ * Screen selection, full-screen clears and the dirty-region flush; what each
+ * screen shows lives in Screens.cpp
  */
 
 #include "Display.h"
-
-Display::Display() {
-    // Constructor - nothing to initialize
+#include "Trace.h"
+#include "Profiler.h"
+
+Display::Display()
+    : canvas(),
+      buffered(false),
+      headless(false),
+      screen(nullptr),
+      theme(&THEMES[0]),
+      themeChanged(false),
+      screenBgColor(THEMES[0].states[STATE_IDLE].background),
+      dirty(),
+      framesPushed(0),
+      bytesPushed(0),
+      arcPixels(0),
+      arcFrames(0) {
 }
 
-void Display::drawCircularProgress(float progress, uint16_t color, TimerState state) {
-    // Draw a static full white circle ring (no progress updates)
-    uint16_t bgColor = getStateBackgroundColor(state, state);
-    int16_t outerRadius = CIRCLE_RADIUS + CIRCLE_THICKNESS/2;
-    int16_t innerRadius = CIRCLE_RADIUS - CIRCLE_THICKNESS/2;
-    
-    // Draw a full solid white ring by filling the outer circle and clearing the inner circle
-    // First, draw filled outer circle
-    M5Dial.Display.fillCircle(CENTER_X, CENTER_Y, outerRadius, color);
-    // Then, clear the inner circle to create the ring
-    M5Dial.Display.fillCircle(CENTER_X, CENTER_Y, innerRadius, bgColor);
-}
+bool Display::begin() {
+    // Nothing to show: skip the caches and the back buffer, render() only binds
+    headless = hal.display->isHeadless();
+    if (headless) return false;
 
-void Display::drawTimerDisplay(uint32_t seconds, uint16_t color, TimerState state,
-                               uint32_t duration, uint32_t remaining,
-                               TimerState lastState, float& lastProgress) {
-    // Calculate progress
-    float progress = duration > 0 ? 1.0 - ((float)remaining / (float)duration) : 0.0;
-    
-    // Get background color based on state
-    uint16_t bgColor = getStateBackgroundColor(state, state);
-    
-    // Redraw everything if state changed, or on first draw
-    bool fullRedraw = (lastState != state) || (lastProgress < 0);
-    
-    if (fullRedraw) {
-        // Full screen clear with state background color
-        M5Dial.Display.fillScreen(bgColor);
-        // Draw white circle only if enabled
-        if (SHOW_WHITE_CIRCLE) {
-            drawCircularProgress(progress, COLOR_TEXT, state); // Draw static white circle
-        }
-        // Draw tomato icon after screen clear
-        drawTomatoIcon(state);
-        lastProgress = progress;
-    }
-    // Circle is static - no need to update it based on progress changes
-    
-    // Always redraw time text in white (it changes every second, or when adjusting)
-    // Position timer in the exact center of the circle
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextDatum(middle_center);
-    M5Dial.Display.setTextSize(5); // Bigger font size (was 4)
-    // Clear area behind text first with state background - centered
-    int16_t timerY = CENTER_Y; // Exact center of circle
-    M5Dial.Display.fillRect(CENTER_X - 80, timerY - 25, 160, 45, bgColor); // Larger clear area for bigger text
-    M5Dial.Display.drawString(formatTime(seconds).c_str(), CENTER_X, timerY);
-    
-    // Draw status text inside the circle, below the timer
-    const char* statusText = "";
-    if (state == STATE_IDLE) {
-        statusText = "Ready";
-    } else if (state == STATE_PAUSED) {
-        statusText = "Paused";
-    } else if (state == STATE_RUNNING) {
-        statusText = "Focusing";
-    } else if (state == STATE_SHORT_BREAK) {
-        statusText = "Short Break";
+    // Decode icons once so redraws never touch the filesystem
+    icons.load();
+
+    // Map the ring's pixels to arc steps once so a frame only walks the swept wedge
+    if (SHOW_PROGRESS_ARC) arc.build();
+
+    if (!USE_SPRITE_BUFFER) return false;
+
+    // Full-screen RGB565 canvas is ~115 KB: prefer PSRAM, fall back to internal RAM
+    canvas.setColorDepth(16);
+    canvas.setPsram(psramFound());
+    buffered = canvas.createSprite(SCREEN_WIDTH, SCREEN_HEIGHT) != nullptr;
+    if (buffered) {
+        canvas.fillScreen(theme->states[STATE_IDLE].background); // Match the panel contents after setup()
+        Serial.println("Display: sprite back buffer enabled");
     } else {
-        statusText = "Long Break";
+        Serial.println("Display: not enough RAM for back buffer - drawing direct");
     }
-    
-    // Clear area for status text inside circle - positioned below centered timer
-    M5Dial.Display.fillRect(CENTER_X - 60, CENTER_Y + 30, 120, 20, bgColor);
-    M5Dial.Display.setTextColor(TFT_WHITE);
-    M5Dial.Display.setTextDatum(middle_center);
-    M5Dial.Display.setTextSize(2); // Bigger text size
-    M5Dial.Display.drawString(statusText, CENTER_X, CENTER_Y + 40); // Positioned lower (was +35)
-    
-    // No moving indicator dot - static circle only
+    return buffered;
 }
 
-void Display::drawStatusText(const char* text, uint16_t color, TimerState state, TimerState lastState) {
-    // Status text is now drawn inside the circle in drawTimerDisplay
-    // This function draws the instructions and settings gear at the bottom
-    
-    // Get background color based on state
-    uint16_t bgColor = getStateBackgroundColor(state, state);
-    
-    // Draw instructions at bottom (moved higher to avoid gear icon)
-    int16_t instructionY = SCREEN_HEIGHT - 48;
-    M5Dial.Display.fillRect(0, instructionY - 10, SCREEN_WIDTH, 20, bgColor);
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextSize(1);
-    const char* instruction = "";
-    if (state == STATE_IDLE) {
-        instruction = "Press: Start | Hold: Reset";
-    } else if (state == STATE_PAUSED) {
-        instruction = "Press: Resume | Hold: Reset";
-    } else {
-        instruction = "Press: Pause | Hold: Reset";
-    }
-    M5Dial.Display.drawString(instruction, CENTER_X, instructionY);
-    
-    // Draw settings gear icon at bottom center (only when not in settings)
-    // Simple approach: always draw when state changed from what was displayed last frame
-    if (state != STATE_SETTINGS && lastState != state) {
-        Serial.println(">>> Drawing gear icon (state changed)!");
-        int16_t iconY = SCREEN_HEIGHT - 20;
-        int16_t iconSize = 24;
-        int16_t iconX = CENTER_X - iconSize/2;
-        int16_t iconYPos = iconY - iconSize/2;
-        
-        // Clear area for icon
-        M5Dial.Display.fillRect(CENTER_X - 15, iconY - 15, 30, 30, bgColor);
-        
-        // Load and draw gear icon from SPIFFS
-        File gearFile = SPIFFS.open("/gear.png", "r");
-        if (gearFile) {
-            bool result = M5Dial.Display.drawPng(&gearFile, iconX, iconYPos);
-            gearFile.close();
-            if (!result) {
-                Serial.println("PNG draw failed - using fallback");
-                M5Dial.Display.setTextColor(TFT_WHITE);
-                M5Dial.Display.setTextDatum(middle_center);
-                M5Dial.Display.setTextSize(2);
-                M5Dial.Display.drawString("\xE2\x9A\x99", CENTER_X, iconY);
-            } else {
-                Serial.println("Gear PNG drawn successfully");
-            }
-        } else {
-            Serial.println("Failed to open gear.png - using fallback");
-            M5Dial.Display.setTextColor(TFT_WHITE);
-            M5Dial.Display.setTextDatum(middle_center);
-            M5Dial.Display.setTextSize(2);
-            M5Dial.Display.drawString("\xE2\x9A\x99", CENTER_X, iconY);
-        }
-    }
+LovyanGFX& Display::gfx() {
+    if (buffered) return canvas;
+    return hal.display->panel();
 }
 
-void Display::drawCurvedText(const char* text, int16_t centerX, int16_t centerY, int16_t radius, float startAngle, uint16_t color) {
-    // Draw text along a circular arc
-    M5Dial.Display.setTextColor(color);
-    M5Dial.Display.setTextSize(1);
-    
-    int len = strlen(text);
-    float angleStep = (2.0 * PI) / len; // Distribute characters evenly around the arc
-    
-    for (int i = 0; i < len; i++) {
-        float angle = startAngle + (i * angleStep);
-        int16_t x = centerX + (int16_t)(radius * cos(angle));
-        int16_t y = centerY - (int16_t)(radius * sin(angle));
-        
-        // Draw character at this position
-        char ch[2] = {text[i], '\0'};
-        M5Dial.Display.drawString(ch, x, y);
-    }
+void Display::unionRect(Rect& a, const Rect& b) {
+    int16_t nx = min(a.x, b.x);
+    int16_t ny = min(a.y, b.y);
+    a.w = max(a.x + a.w, b.x + b.w) - nx;
+    a.h = max(a.y + a.h, b.y + b.h) - ny;
+    a.x = nx;
+    a.y = ny;
 }
 
-void Display::drawPomodoroCounter(uint8_t completedPomodoros, TimerState state) {
-    // Get background color based on state
-    uint16_t bgColor = getStateBackgroundColor(state, state);
-    
-    // Clear area at the top (use state background)
-    M5Dial.Display.fillRect(0, 0, SCREEN_WIDTH, 35, bgColor);
-    
-    // Draw pomodoro count text at the top center (slightly lower)
-    char pomoText[25];
-    snprintf(pomoText, sizeof(pomoText), "Pomodoros: %d", completedPomodoros);
-    
-    // Draw text at the top center - simple and visible
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextSize(1);
-    M5Dial.Display.setTextDatum(middle_center);
-    M5Dial.Display.drawString(pomoText, CENTER_X, 20); // Lowered from 15 to 20
+void Display::markDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // Clip to the panel
+    int16_t x1 = x + w;
+    int16_t y1 = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > SCREEN_WIDTH) x1 = SCREEN_WIDTH;
+    if (y1 > SCREEN_HEIGHT) y1 = SCREEN_HEIGHT;
+    if (x1 <= x || y1 <= y) return;
+
+    if (!buffered) {
+        // Drawing straight to the panel: every primitive goes over SPI
+        bytesPushed += (uint32_t)(x1 - x) * (y1 - y) * 2;
+    }
+
+    Rect r = { x, y, (int16_t)(x1 - x), (int16_t)(y1 - y) };
+    if (dirty.w == 0) dirty = r;
+    else unionRect(dirty, r);
 }
 
-void Display::drawTomatoIcon(TimerState state) {
-    // Draw tomato icon between pomodoro counter (y=20) and timer (y=120)
-    // Position it slightly higher: around y=60
-    int16_t iconY = 60; // Slightly higher than middle (was 70)
-    int16_t iconSize = 32; // PNG is 32x32
-    int16_t iconX = CENTER_X - iconSize/2;
-    int16_t iconYPos = iconY - iconSize/2;
-    
-    // Use M5GFX's drawPng via Stream to load PNG from SPIFFS with transparency support
-    File tomatoFile = SPIFFS.open("/pomodoro.png", "r");
-    if (tomatoFile) {
-        bool result = M5Dial.Display.drawPng(&tomatoFile, iconX, iconYPos);
-        tomatoFile.close();
-        if (!result) {
-            Serial.println("Failed to draw PNG");
-            M5Dial.Display.fillRect(iconX, iconYPos, iconSize, iconSize, TFT_RED);
-        } else {
-            Serial.println("PNG drawn successfully");
+void Display::flush() {
+    if (dirty.w == 0) return; // Nothing changed
+
+    if (buffered) {
+        // One address window over everything that changed, streamed straight
+        // from the back buffer by DMA a row at a time (rows are contiguous there)
+        const Rect& r = dirty;
+        const lgfx::swap565_t* pixels = (const lgfx::swap565_t*)canvas.getBuffer();
+        LovyanGFX& panel = hal.display->panel();
+        panel.startWrite();
+        panel.setWindow(r.x, r.y, r.x + r.w - 1, r.y + r.h - 1);
+        for (int16_t y = r.y; y < r.y + r.h; y++) {
+            panel.writePixelsDMA(pixels + (size_t)y * SCREEN_WIDTH + r.x, r.w);
         }
-    } else {
-        Serial.println("Failed to open /pomodoro.png from SPIFFS");
-        M5Dial.Display.fillRect(iconX, iconYPos, iconSize, iconSize, TFT_RED);
+        panel.waitDMA();        // The next frame draws into these rows
+        panel.endWrite();
+        bytesPushed += (uint32_t)r.w * r.h * 2;
     }
+    framesPushed++;
+    dirty.w = 0;
 }
 
-void Display::drawSettingsMenu(const PomodoroSettings& settings, uint8_t menuIndex,
-                               bool editing, TimerState lastState) {
-    // Clear screen if we just entered settings (transitioning from another state)
-    if (lastState != STATE_SETTINGS) {
-        M5Dial.Display.fillScreen(COLOR_BG);
-        Serial.println("Clearing screen for Settings entry");
+void Display::clearScreen(uint16_t color) {
+    TRACE(TRACE_SCREEN_CLEAR, color, 0);
+    gfx().fillScreen(color);
+    screenBgColor = color;
+    themeChanged = false;
+    dirty.w = 0; // Whole screen supersedes any pending region
+    markDirty(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+void Display::render(const DisplaySnapshot& frame) {
+    Screen& next = screens.forState(frame.state);
+    {
+        PROFILE_SCOPE(PHASE_UI_BIND);
+        next.bind(frame, *theme);
     }
-    
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextDatum(top_center);
-    M5Dial.Display.setTextSize(2);
-    M5Dial.Display.drawString("Settings", CENTER_X, 10);
-    
-    M5Dial.Display.setTextSize(1);
-    int16_t yPos = 50;
-    
-    // Clear the menu area before redrawing to remove old highlights
-    M5Dial.Display.fillRect(0, 40, SCREEN_WIDTH, 165, COLOR_BG);
 
-    const char* menuItems[] = {
-        "Work Duration",
-        "Short Break",
-        "Long Break",
-        "Pomodoros/Long",
-        "Brightness",
-        "Back"
-    };
+    if (headless) {
+        // Widgets keep their state as if painted; no pixel is touched
+        for (Widget* w = next.getWidgets(); w; w = w->next) w->markClean();
+        screen = &next;
+        return;
+    }
 
-    for (uint8_t i = 0; i < 6; i++) {
-        // Clear the specific line area first
-        M5Dial.Display.fillRect(10, yPos - 2, SCREEN_WIDTH - 20, 18, COLOR_BG);
+    // Same screen over the same background: widgets repaint only what changed
+    if (&next != screen || next.getBackground() != screenBgColor || themeChanged) {
+        clearScreen(next.getBackground());
+        next.invalidate();
+        screen = &next;
+    }
 
-        // Draw highlight only for selected item
-        if (i == menuIndex) {
-            M5Dial.Display.fillRect(10, yPos - 2, SCREEN_WIDTH - 20, 18, COLOR_PROGRESS_BG);
-            M5Dial.Display.setTextColor(COLOR_WORK);
-        } else {
-            M5Dial.Display.setTextColor(COLOR_TEXT);
-        }
+    PROFILE_SCOPE(next.getPhase());
+    for (Widget* w = next.getWidgets(); w; w = w->next) {
+        if (!w->isDirty()) continue;
+        w->paint(*this);
+        w->markClean();
+    }
+}
 
-        char line[50];
-        if (i == 0) {
-            // Work Duration - editable
-            snprintf(line, sizeof(line), "%s: %s", menuItems[i], formatTime(settings.workDuration).c_str());
-        } else if (i == 1) {
-            // Short Break - editable
-            snprintf(line, sizeof(line), "%s: %s", menuItems[i], formatTime(settings.shortBreakDuration).c_str());
-        } else if (i == 2) {
-            // Long Break - editable
-            snprintf(line, sizeof(line), "%s: %s", menuItems[i], formatTime(settings.longBreakDuration).c_str());
-        } else if (i == 3) {
-            // Pomodoros until long break - editable
-            snprintf(line, sizeof(line), "%s: %d", menuItems[i], settings.pomodorosUntilLongBreak);
-        } else if (i == 4) {
-            // Brightness level - editable
-            snprintf(line, sizeof(line), "%s: Level %d/6", menuItems[i], settings.brightnessLevel);
-        } else {
-            // Back
-            snprintf(line, sizeof(line), "%s", menuItems[i]);
-        }
+void Display::fillRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    gfx().fillRect(x, y, w, h, color);
+    markDirty(x, y, w, h);
+}
 
-        M5Dial.Display.drawString(line, CENTER_X, yPos);
-        yPos += 25;
-    }
-    
-    // Instructions (clear area first) - moved higher to be fully visible
-    M5Dial.Display.fillRect(0, SCREEN_HEIGHT - 45, SCREEN_WIDTH, 45, COLOR_BG);
-    M5Dial.Display.setTextColor(COLOR_TEXT);
-    M5Dial.Display.setTextSize(1);
-    M5Dial.Display.drawString("Dial: Navigate/Adjust", CENTER_X, SCREEN_HEIGHT - 35);
-    M5Dial.Display.drawString("Press: Select/Edit", CENTER_X, SCREEN_HEIGHT - 20);
+void Display::drawText(const char* text, int16_t x, int16_t y) {
+    LovyanGFX& g = gfx();
+    g.drawString(text, x, y);
+
+    // Work out the text box from the current datum
+    int16_t w = g.textWidth(text);
+    int16_t h = g.fontHeight();
+    uint8_t datum = g.getTextDatum();
+    if ((datum & 3) == 1) x -= w / 2;      // *_center
+    else if ((datum & 3) == 2) x -= w;     // *_right
+    if ((datum & 12) == 4) y -= h / 2;     // middle_*
+    else if ((datum & 12) != 0) y -= h;    // bottom_* / baseline_*
+    markDirty(x - 1, y - 1, w + 2, h + 2);
 }
 
-String Display::formatTime(uint32_t seconds) {
-    uint32_t minutes = seconds / 60;
-    uint32_t secs = seconds % 60;
-    
-    char buffer[10];
-    snprintf(buffer, sizeof(buffer), "%02lu:%02lu", minutes, secs);
-    return String(buffer);
+void Display::fillBox(const UiRect& box, uint16_t color) {
+    fillRegion(box.x, box.y, box.w, box.h, color);
 }
 
-uint16_t Display::getStateColor(TimerState state) {
-    switch (state) {
-        case STATE_RUNNING:
-            return COLOR_WORK;
-        case STATE_SHORT_BREAK:
-            return COLOR_BREAK;
-        case STATE_LONG_BREAK:
-            return COLOR_LONG_BREAK;
-        case STATE_PAUSED:
-            return 0x7BEF; // Yellow
-        default:
-            return COLOR_TEXT;
-    }
+void Display::setTextStyle(const UiText& text, uint16_t color) {
+    gfx().setTextColor(color);
+    gfx().setTextDatum(text.datum);
+    gfx().setTextSize(text.size);
+}
+
+bool Display::drawIcon(IconId id, uint16_t bgColor, int16_t x, int16_t y) {
+    if (!icons.draw(gfx(), id, bgColor, x, y)) return false;
+    int16_t size = icons.getSize(id);
+    markDirty(x, y, size, size);
+    return true;
 }
 
-uint16_t Display::getStateBackgroundColor(TimerState state, TimerState stateBeforePause) {
-    switch (state) {
-        case STATE_RUNNING:
-            return COLOR_WORK_BG; // Red background
-        case STATE_SHORT_BREAK:
-            return COLOR_SHORT_BREAK_BG; // Green background
-        case STATE_LONG_BREAK:
-            return COLOR_LONG_BREAK_BG; // Orange background for long break
-        case STATE_PAUSED:
-            // When paused, keep the color of the state that was paused
-            // Use stateBeforePause to determine the background color
-            switch (stateBeforePause) {
-                case STATE_RUNNING:
-                    return COLOR_WORK_BG; // Red background
-                case STATE_SHORT_BREAK:
-                    return COLOR_SHORT_BREAK_BG; // Green background
-                case STATE_LONG_BREAK:
-                    return COLOR_LONG_BREAK_BG; // Orange background
-                default:
-                    return COLOR_BG; // Default to black
-            }
-        default:
-            return COLOR_WORK_BG; // Red background for idle (default)
+bool Display::drawGlyph(char ch, uint16_t fgColor, uint16_t bgColor, int16_t x, int16_t y) {
+    if (!glyphs.draw(gfx(), ch, fgColor, bgColor, x, y)) return false;
+    markDirty(x, y, glyphs.getCellWidth(), GlyphAtlas::CELL_HEIGHT);
+    return true;
+}
+
+void Display::drawProgressArc(uint16_t step, int32_t lastStep,
+                              uint16_t arcColor, uint16_t trackColor, uint16_t bgColor) {
+    int16_t x0 = SCREEN_WIDTH, y0 = SCREEN_HEIGHT, x1 = 0, y1 = 0;
+    uint32_t pixels = 0;
+    if (lastStep < 0) {
+        // Whole ring: elapsed part, then the track
+        pixels += arc.draw(gfx(), 0, step, arcColor, bgColor, x0, y0, x1, y1);
+        pixels += arc.draw(gfx(), step, PROGRESS_ARC_STEPS, trackColor, bgColor, x0, y0, x1, y1);
+    } else if (step > lastStep) {
+        // Only the wedge swept since the last frame
+        pixels += arc.draw(gfx(), lastStep, step, arcColor, bgColor, x0, y0, x1, y1);
+    } else if (step < lastStep) {
+        // Progress went back (new session): hand the wedge back to the track
+        pixels += arc.draw(gfx(), step, lastStep, trackColor, bgColor, x0, y0, x1, y1);
     }
+    if (pixels == 0) return;
+    arcPixels += pixels;
+    arcFrames++;
+    markDirty(x0, y0, x1 - x0, y1 - y0);
 }
 
+const char* Display::formatHours(uint32_t seconds, char* buffer, size_t size) {
+    uint32_t minutes = seconds / 60;
+    snprintf(buffer, size, "%luh %02lum", (unsigned long)(minutes / 60), (unsigned long)(minutes % 60));
+    return buffer;
+}
+
+const char* Display::formatTime(uint32_t seconds, char* buffer, size_t size) {
+    // Writes into caller-provided storage - no heap allocation
+    uint32_t minutes = seconds / 60;
+    uint32_t secs = seconds % 60;
+    
+    snprintf(buffer, size, "%02lu:%02lu", (unsigned long)minutes, (unsigned long)secs);
+    return buffer;
+}
+
+void Display::setTheme(uint8_t index) {
+    if (index >= THEME_COUNT) index = 0;
+    if (&THEMES[index] == theme) return;
+    // Resolved once here; draws read colors through the pointer
+    theme = &THEMES[index];
+    themeChanged = true;
+}
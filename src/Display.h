@@ -1,43 +1,113 @@
 /**
- * Display Module - All UI drawing functions
- * Handles all visual rendering for the Pomodoro Timer
+ * Display Module - Renderer and painting primitives
+ * Renders published frames through the retained screens in Screens.h and
+ * pushes only the region they touched to the panel
  */
 
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
 #include <Arduino.h>
-#include <SPIFFS.h>
-#include <M5Dial.h>
+#include <M5GFX.h>
 #include "config.h"
+#include "hal/Hal.h"
 #include "types.h"
+#include "IconCache.h"
+#include "GlyphAtlas.h"
+#include "ProgressArc.h"
+#include "Theme.h"
+#include "Screens.h"
 
 class Display {
 public:
     // Constructor
     Display();
-    
-    // Main drawing functions
-    void drawTimerDisplay(uint32_t seconds, uint16_t color, TimerState state, 
-                         uint32_t duration, uint32_t remaining, 
-                         TimerState lastState, float& lastProgress);
-    void drawStatusText(const char* text, uint16_t color, TimerState state, TimerState lastState);
-    void drawPomodoroCounter(uint8_t completedPomodoros, TimerState state);
-    void drawTomatoIcon(TimerState state);
-    void drawSettingsMenu(const PomodoroSettings& settings, uint8_t menuIndex, 
-                         bool editing, TimerState lastState);
-    
+
+    // Allocate the off-screen back buffer and decode icons (call after the HAL is installed)
+    bool begin();
+
+    // Push everything drawn since the last flush to the panel
+    void flush();
+
+    // Bind the frame to the screen for its state and paint the widgets that changed;
+    // the screen is cleared first when the screen, its background or the theme changed
+    void render(const DisplaySnapshot& frame);
+
     // Helper functions
-    String formatTime(uint32_t seconds);
-    uint16_t getStateColor(TimerState state);
-    uint16_t getStateBackgroundColor(TimerState state, TimerState stateBeforePause);
-    
+    static const size_t TIME_TEXT_SIZE = 12; // Fits "MM:SS" for any uint32_t seconds
+    static const char* formatTime(uint32_t seconds, char* buffer, size_t size);
+    static const char* formatHours(uint32_t seconds, char* buffer, size_t size);  // "12h 05m"
+
+    // Colors come from THEMES[index]; switching repaints the whole screen on the next draw
+    void setTheme(uint8_t index);
+    const Theme& getTheme() const { return *theme; }
+
+    // Render statistics (for performance monitoring)
+    bool isBuffered() const { return buffered; }
+    uint32_t getFramesPushed() const { return framesPushed; }
+    uint32_t getBytesPushed() const { return bytesPushed; }
+    uint32_t getArcPixels() const { return arcPixels; }      // Pixels rasterized by the progress arc
+    uint32_t getArcFrames() const { return arcFrames; }      // Draws that moved the arc
+    void resetStats() {
+        framesPushed = 0; bytesPushed = 0; arcPixels = 0; arcFrames = 0;
+        icons.resetStats(); glyphs.resetStats();
+    }
+    const IconCache& getIconCache() const { return icons; }
+    const GlyphAtlas& getGlyphAtlas() const { return glyphs; }
+    const ProgressArc& getProgressArc() const { return arc; }
+
+    // Painting primitives for widgets: draw to the target and record the touched region
+    LovyanGFX& gfx();           // The back buffer when available, otherwise the panel
+    void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+    void fillRegion(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void fillBox(const UiRect& box, uint16_t color);
+    void setTextStyle(const UiText& text, uint16_t color);
+    void drawText(const char* text, int16_t x, int16_t y);
+    // Cached blits; return false if the icon or glyph is not available
+    bool drawIcon(IconId id, uint16_t bgColor, int16_t x, int16_t y);
+    bool drawGlyph(char ch, uint16_t fgColor, uint16_t bgColor, int16_t x, int16_t y);
+    // Progress ring from lastStep to step; lastStep -1 draws the whole ring
+    void drawProgressArc(uint16_t step, int32_t lastStep,
+                         uint16_t arcColor, uint16_t trackColor, uint16_t bgColor);
+
 private:
-    // Internal drawing helpers
-    void drawCircularProgress(float progress, uint16_t color, TimerState state);
-    void drawCurvedText(const char* text, int16_t centerX, int16_t centerY, 
-                       int16_t radius, float startAngle, uint16_t color);
+    struct Rect {
+        int16_t x, y, w, h;
+    };
+
+    // Off-screen back buffer (falls back to drawing on the panel if allocation fails)
+    M5Canvas canvas;
+    bool buffered;
+    bool headless;             // No panel to draw for (see HalDisplay::isHeadless)
+
+    // Pre-decoded PNG icons
+    IconCache icons;
+
+    // Pre-rendered countdown digits
+    GlyphAtlas glyphs;
+
+    // Per-step span table for the progress ring
+    ProgressArc arc;
+
+    // Retained widget trees, one screen per state
+    ScreenSet screens;
+    Screen* screen;            // Screen on the panel (nullptr before the first render)
+    const Theme* theme;        // Current entry of THEMES
+    bool themeChanged;         // Switched since the last full-screen clear
+    uint16_t screenBgColor;    // Color of the last full-screen clear
+
+    // Bounding box of everything drawn since the last flush (w == 0: nothing)
+    Rect dirty;
+
+    // Render statistics
+    uint32_t framesPushed;
+    uint32_t bytesPushed;
+    uint32_t arcPixels;
+    uint32_t arcFrames;
+
+    static void unionRect(Rect& a, const Rect& b); // Grow a to cover b
+
+    void clearScreen(uint16_t color);
 };
 
 #endif // DISPLAY_H
-
@@ -0,0 +1,51 @@
+/**
+ * Fixed-Point Trigonometry Implementation
+ * atan2 as a search of the sine table: octant reduction, a binary search on
+ * cross products, then linear interpolation between the two bracketing rows
+ */
+
+#include "FixedTrig.h"
+
+static const uint16_t OCTANT = TRIG_STEPS / 8;
+static const uint32_t FINE_PER_STEP = FINE_ANGLE_TURN / TRIG_STEPS;
+
+// Angle whose tangent is minor / major (minor <= major), in fine units, 0 .. 1/8 turn
+static uint32_t octantAngle(int64_t minor, int64_t major) {
+    // Largest table angle a with minor * cos(a) >= major * sin(a)
+    uint16_t low = 0, high = OCTANT;
+    while (high - low > 1) {
+        uint16_t mid = (low + high) / 2;
+        if (minor * cosQ15(mid) >= major * sinQ15(mid)) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    // Interpolate between rows low and low + 1 where the cross product changes sign
+    int64_t before = minor * cosQ15(low) - major * sinQ15(low);
+    int64_t after = minor * cosQ15(low + 1) - major * sinQ15(low + 1);
+    uint32_t fraction = before > 0 ? (uint32_t)((before * FINE_PER_STEP) / (before - after)) : 0;
+    if (fraction > FINE_PER_STEP) fraction = FINE_PER_STEP;
+    return low * FINE_PER_STEP + fraction;
+}
+
+uint16_t screenAngle(int32_t dx, int32_t dy) {
+    // East and north components (screen y grows downwards)
+    int64_t east = dx;
+    int64_t north = -(int64_t)dy;
+    int64_t ax = east < 0 ? -east : east;
+    int64_t ay = north < 0 ? -north : north;
+    if (ax == 0 && ay == 0) return 0;
+
+    // Angle from the vertical axis within the quadrant
+    uint32_t quarter = FINE_ANGLE_TURN / 4;
+    uint32_t angle = ax <= ay ? octantAngle(ax, ay) : quarter - octantAngle(ay, ax);
+
+    // Unfold into the quadrant, clockwise from 12 o'clock
+    if (east >= 0) {
+        angle = north >= 0 ? angle : 2 * quarter - angle;
+    } else {
+        angle = north >= 0 ? FINE_ANGLE_TURN - angle : 2 * quarter + angle;
+    }
+    return (uint16_t)(angle & (FINE_ANGLE_TURN - 1));
+}
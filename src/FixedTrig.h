@@ -0,0 +1,68 @@
+/**
+ * Fixed-Point Trigonometry
+ * A Q15 sine table generated at compile time, and integer polar helpers for
+ * everything drawn around the round panel, so render paths make no libm
+ * calls and do no float math.
+ *
+ * Angles are measured clockwise from 12 o'clock, in screen coordinates:
+ * table angles in 1/TRIG_STEPS of a turn, fine angles in 1/65536 of a turn.
+ */
+
+#ifndef FIXED_TRIG_H
+#define FIXED_TRIG_H
+
+#include <stdint.h>
+
+const uint16_t TRIG_STEPS = 1024;          // Table angle units per turn (power of two)
+const uint32_t FINE_ANGLE_TURN = 65536;    // Fine angle units per turn
+const int32_t Q15_ONE = 32768;
+
+struct SineTable {
+    int16_t values[TRIG_STEPS];             // sin(2 pi i / TRIG_STEPS) in Q15 (1.0 clamps to 32767)
+};
+
+// Taylor series on [0, pi/2]; only ever evaluated by the compiler
+constexpr double quarterSine(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr SineTable makeSineTable() {
+    SineTable table = {};
+    const uint16_t quarter = TRIG_STEPS / 4;
+    const double halfPi = 1.57079632679489661923;
+    for (uint16_t i = 0; i < TRIG_STEPS; i++) {
+        // Fold into the first quadrant, then mirror the sign
+        uint16_t q = i / quarter;
+        uint16_t r = i % quarter;
+        uint16_t folded = (q & 1) ? quarter - r : r;
+        double s = quarterSine(halfPi * folded / quarter);
+        int32_t value = (int32_t)(s * Q15_ONE + 0.5);
+        if (value > 32767) value = 32767;
+        table.values[i] = (int16_t)(q >= 2 ? -value : value);
+    }
+    return table;
+}
+
+inline constexpr SineTable SINE_TABLE = makeSineTable();
+
+// Table lookups (angle wraps)
+inline int16_t sinQ15(uint16_t angle) { return SINE_TABLE.values[angle & (TRIG_STEPS - 1)]; }
+inline int16_t cosQ15(uint16_t angle) { return SINE_TABLE.values[(angle + TRIG_STEPS / 4) & (TRIG_STEPS - 1)]; }
+
+// Point at radius and table angle from the center, rounded to the nearest pixel
+inline void polarToScreen(int16_t centerX, int16_t centerY, int16_t radius, uint16_t angle,
+                          int16_t& x, int16_t& y) {
+    x = centerX + (int16_t)(((int32_t)radius * sinQ15(angle) + Q15_ONE / 2) >> 15);
+    y = centerY - (int16_t)(((int32_t)radius * cosQ15(angle) + Q15_ONE / 2) >> 15);
+}
+
+// Direction of dx,dy from the center as a fine angle (integer atan2 on the table)
+uint16_t screenAngle(int32_t dx, int32_t dy);
+
+#endif // FIXED_TRIG_H
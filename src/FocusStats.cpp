@@ -0,0 +1,106 @@
+/**
+ * Focus Statistics Implementation
+ */
+
+#include "FocusStats.h"
+
+FocusStats::FocusStats()
+    : rebuildEntries(0),
+      rebuildUs(0) {
+    clear();
+}
+
+void FocusStats::clear() {
+    haveDay = false;
+    lastDay = 0;
+    currentWeek = 0;
+    currentMonth = 0;
+    todaySeconds = 0;
+    weekSeconds = 0;
+    monthSeconds = 0;
+    streakDays = 0;
+    bestStreakDays = 0;
+    focusSessions = 0;
+    focusSeconds = 0;
+}
+
+uint32_t FocusStats::monthOf(uint32_t day) {
+    // Civil date from a day number (H. Hinnant's days_from_civil, inverted)
+    uint32_t z = day + 719468;
+    uint32_t era = z / 146097;
+    uint32_t dayOfEra = z - era * 146097;
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t mp = (5 * dayOfYear + 2) / 153;                   // March = 0
+    uint32_t month = mp < 10 ? mp + 3 : mp - 9;                // 1-12
+    uint32_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    return year * 12 + month - 1;
+}
+
+uint32_t FocusStats::rebuild(const SessionHistory& history) {
+    uint32_t start = micros();
+    clear();
+    rebuildEntries = history.read(replay, this);
+    rebuildUs = micros() - start;
+
+    Serial.print("Stats: rebuilt from ");
+    Serial.print(rebuildEntries);
+    Serial.print(" sessions in ");
+    Serial.print(rebuildUs / 1000);
+    Serial.println(" ms");
+    return rebuildEntries;
+}
+
+void FocusStats::replay(const HistoryEntry& entry, void* context) {
+    ((FocusStats*)context)->record(entry);
+}
+
+void FocusStats::record(const HistoryEntry& entry) {
+    if (entry.kind != STATE_RUNNING) return;
+    focusSessions++;
+    focusSeconds += entry.duration;
+    if (!entry.wallClock) return;   // Can't be placed on the calendar
+
+    uint32_t day = dayOf(entry.endTime);
+    uint32_t week = weekOf(day);
+    uint32_t month = monthOf(day);
+
+    if (haveDay && day < lastDay) {
+        // Clock set backwards: count it only in the windows that are still open
+        if (week == currentWeek) weekSeconds += entry.duration;
+        if (month == currentMonth) monthSeconds += entry.duration;
+        return;
+    }
+
+    if (!haveDay || day != lastDay) {
+        // First session of a new day: roll the windows it leaves behind
+        streakDays = (haveDay && day == lastDay + 1) ? streakDays + 1 : 1;
+        if (streakDays > bestStreakDays) bestStreakDays = streakDays;
+        todaySeconds = 0;
+        if (!haveDay || week != currentWeek) weekSeconds = 0;
+        if (!haveDay || month != currentMonth) monthSeconds = 0;
+        lastDay = day;
+        currentWeek = week;
+        currentMonth = month;
+        haveDay = true;
+    }
+    todaySeconds += entry.duration;
+    weekSeconds += entry.duration;
+    monthSeconds += entry.duration;
+}
+
+void FocusStats::summarize(uint32_t now, StatsSummary& summary) const {
+    summary.focusSessions = focusSessions;
+    summary.averageSeconds = focusSessions ? focusSeconds / focusSessions : 0;
+    summary.bestStreakDays = bestStreakDays;
+
+    // Windows that have rolled over since the newest session read as empty
+    uint32_t today = dayOf(now);
+    bool dated = now != 0 && haveDay && today >= lastDay;
+    summary.wallClock = now != 0;
+    summary.todaySeconds = dated && today == lastDay ? todaySeconds : 0;
+    summary.weekSeconds = dated && weekOf(today) == currentWeek ? weekSeconds : 0;
+    summary.monthSeconds = dated && monthOf(today) == currentMonth ? monthSeconds : 0;
+    // The streak survives until a whole day goes by without a session
+    summary.streakDays = dated && today - lastDay <= 1 ? streakDays : 0;
+}
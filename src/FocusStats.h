@@ -0,0 +1,71 @@
+/**
+ * Focus Statistics
+ * Today / week / month focus time, day streaks and average session length,
+ * kept as running aggregates: each completed session updates them in O(1)
+ * and the engine holds no per-session state. The session history log is only
+ * replayed once, at boot, to rebuild them.
+ *
+ * Calendar figures use the wall clock (the RTC's local time); a session counts
+ * toward the day it ended on. Sessions logged without a wall clock only count
+ * toward the lifetime totals.
+ */
+
+#ifndef FOCUS_STATS_H
+#define FOCUS_STATS_H
+
+#include <Arduino.h>
+#include "types.h"
+#include "SessionHistory.h"
+
+class FocusStats {
+public:
+    // Constructor
+    FocusStats();
+
+    // Forget everything
+    void clear();
+
+    // Replay the history log (call once at boot); returns the entries read
+    uint32_t rebuild(const SessionHistory& history);
+
+    // Account for one completed session (work sessions only; breaks are ignored)
+    void record(const HistoryEntry& entry);
+
+    // Figures as of `now` (wall clock seconds; 0 = unknown, calendar figures read 0)
+    void summarize(uint32_t now, StatsSummary& summary) const;
+
+    // Statistics (for performance monitoring)
+    uint32_t getRebuildEntries() const { return rebuildEntries; }
+    uint32_t getRebuildUs() const { return rebuildUs; }
+
+    // Calendar helpers: days since 1970-01-01, weeks starting on Monday,
+    // months as year * 12 + month
+    static uint32_t dayOf(uint32_t seconds) { return seconds / DAY_S; }
+    static uint32_t weekOf(uint32_t day) { return (day + 3) / 7; }   // 1970-01-01 was a Thursday
+    static uint32_t monthOf(uint32_t day);
+
+private:
+    static const uint32_t DAY_S = 24UL * 60UL * 60UL;
+
+    // Calendar windows, as of the newest dated session
+    bool haveDay;
+    uint32_t lastDay;
+    uint32_t currentWeek;
+    uint32_t currentMonth;
+    uint32_t todaySeconds;
+    uint32_t weekSeconds;
+    uint32_t monthSeconds;
+    uint16_t streakDays;
+    uint16_t bestStreakDays;
+
+    // Lifetime totals
+    uint32_t focusSessions;
+    uint32_t focusSeconds;
+
+    uint32_t rebuildEntries;
+    uint32_t rebuildUs;
+
+    static void replay(const HistoryEntry& entry, void* context);
+};
+
+#endif // FOCUS_STATS_H
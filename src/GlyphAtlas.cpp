@@ -0,0 +1,85 @@
+/**
+ * Glyph Atlas Implementation
+ * Each glyph is rasterized once per color pair; a tick becomes a few row copies
+ */
+
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas()
+    : nextVictim(0),
+      cellWidth(0),
+      buildCount(0),
+      blitCount(0) {
+    for (uint8_t i = 0; i < ATLAS_SLOTS; i++) {
+        atlasFg[i] = 0;
+        atlasBg[i] = 0;
+        atlasValid[i] = false;
+    }
+}
+
+bool GlyphAtlas::draw(LovyanGFX& target, char ch, uint16_t fgColor, uint16_t bgColor, int16_t x, int16_t y) {
+    int8_t glyph = glyphIndex(ch);
+    if (glyph < 0) return false;
+
+    int8_t slot = findAtlas(fgColor, bgColor);
+    if (slot < 0) return false;
+
+    const lgfx::swap565_t* pixels = (const lgfx::swap565_t*)atlases[slot].getBuffer();
+    target.pushImage(x, y, cellWidth, CELL_HEIGHT, pixels + (int32_t)glyph * cellWidth * CELL_HEIGHT);
+    blitCount++;
+    return true;
+}
+
+int8_t GlyphAtlas::findAtlas(uint16_t fgColor, uint16_t bgColor) {
+    for (uint8_t i = 0; i < ATLAS_SLOTS; i++) {
+        if (atlasValid[i] && atlasFg[i] == fgColor && atlasBg[i] == bgColor) return i;
+    }
+
+    // Not cached yet: rebuild the oldest slot for these colors
+    uint8_t slot = nextVictim;
+    nextVictim = (nextVictim + 1) % ATLAS_SLOTS;
+    if (build(slot, fgColor, bgColor)) return slot;
+
+    // Allocation failed - release every other atlas and retry once
+    for (uint8_t i = 0; i < ATLAS_SLOTS; i++) {
+        atlases[i].deleteSprite();
+        atlasValid[i] = false;
+    }
+    if (build(slot, fgColor, bgColor)) return slot;
+    return -1;
+}
+
+bool GlyphAtlas::build(uint8_t slot, uint16_t fgColor, uint16_t bgColor) {
+    static const char GLYPHS[GLYPH_COUNT + 1] = "0123456789:";
+
+    LGFX_Sprite& atlas = atlases[slot];
+    atlas.deleteSprite();
+    atlasValid[slot] = false;
+
+    atlas.setColorDepth(16);
+    atlas.setPsram(psramFound());
+    atlas.setTextSize(TEXT_SIZE);
+    cellWidth = atlas.textWidth("0"); // Fixed-width font: every glyph has the same advance
+    if (!atlas.createSprite(cellWidth, CELL_HEIGHT * GLYPH_COUNT)) return false;
+
+    // Same placement as drawing the string directly: text centered on the time anchor
+    atlas.fillScreen(bgColor);
+    atlas.setTextColor(fgColor);
+    atlas.setTextDatum(middle_center);
+    for (uint8_t i = 0; i < GLYPH_COUNT; i++) {
+        char ch[2] = {GLYPHS[i], '\0'};
+        atlas.drawString(ch, cellWidth / 2, i * CELL_HEIGHT + TEXT_CENTER_Y);
+    }
+
+    atlasFg[slot] = fgColor;
+    atlasBg[slot] = bgColor;
+    atlasValid[slot] = true;
+    buildCount++;
+    return true;
+}
+
+int8_t GlyphAtlas::glyphIndex(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch == ':') return 10;
+    return -1;
+}
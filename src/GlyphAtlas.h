@@ -0,0 +1,54 @@
+/**
+ * Glyph Atlas Module
+ * Pre-rendered "0-9" and ":" cells for the MM:SS countdown
+ */
+
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <Arduino.h>
+#include <M5GFX.h>
+#include "config.h"
+#include "Theme.h"
+
+class GlyphAtlas {
+public:
+    // Constructor
+    GlyphAtlas();
+
+    // Blit one glyph cell at x,y; returns false if ch is not in the atlas
+    // or no atlas could be built for these colors
+    bool draw(LovyanGFX& target, char ch, uint16_t fgColor, uint16_t bgColor, int16_t x, int16_t y);
+
+    // Cell geometry (width is known after the first atlas is built)
+    int16_t getCellWidth() const { return cellWidth; }
+    static const int16_t CELL_HEIGHT = LAYOUT.time.box.h;
+
+    // Statistics (for performance monitoring)
+    uint32_t getBuildCount() const { return buildCount; }
+    uint32_t getBlitCount() const { return blitCount; }
+    void resetStats() { blitCount = 0; }
+
+private:
+    static const uint8_t TEXT_SIZE = LAYOUT.time.text.size;
+    static const int16_t TEXT_CENTER_Y = LAYOUT.time.text.y - LAYOUT.time.box.y;  // Within a cell
+    static const uint8_t GLYPH_COUNT = 11;   // "0123456789:"
+    static const uint8_t ATLAS_SLOTS = 2;    // Color pairs kept at once (~30 KB each)
+
+    // Glyphs are stacked vertically so each cell is one contiguous block of pixels
+    LGFX_Sprite atlases[ATLAS_SLOTS];
+    uint16_t atlasFg[ATLAS_SLOTS];
+    uint16_t atlasBg[ATLAS_SLOTS];
+    bool atlasValid[ATLAS_SLOTS];
+    uint8_t nextVictim;
+
+    int16_t cellWidth;
+    uint32_t buildCount;
+    uint32_t blitCount;
+
+    int8_t findAtlas(uint16_t fgColor, uint16_t bgColor);
+    bool build(uint8_t slot, uint16_t fgColor, uint16_t bgColor);
+    static int8_t glyphIndex(char ch);
+};
+
+#endif // GLYPH_ATLAS_H
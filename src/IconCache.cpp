@@ -0,0 +1,95 @@
+/**
+ * Icon Cache Implementation
+ * Each PNG is read and decoded once; redraws are plain RAM-to-target blits
+ */
+
+#include "IconCache.h"
+
+const IconCache::IconAsset IconCache::ASSETS[ICON_COUNT] = {
+    { "/pomodoro.png", 32 },
+    { "/gear.png", 24 }
+};
+
+IconCache::IconCache()
+    : loadTimeUs(0),
+      blitCount(0),
+      blitTimeUs(0) {
+    for (uint8_t i = 0; i < ICON_COUNT; i++) {
+        for (uint8_t b = 0; b < BG_COUNT; b++) {
+            cached[i][b] = false;
+        }
+    }
+}
+
+bool IconCache::load() {
+    uint32_t start = micros();
+    bool ok = true;
+    for (uint8_t i = 0; i < ICON_COUNT; i++) {
+        ok &= loadIcon((IconId)i);
+    }
+    loadTimeUs = micros() - start;
+
+    Serial.print("Icon cache loaded in ");
+    Serial.print(loadTimeUs);
+    Serial.println(" us");
+    return ok;
+}
+
+bool IconCache::loadIcon(IconId id) {
+    const IconAsset& asset = ASSETS[id];
+
+    // Read the PNG into RAM once so each background is decoded without touching the filesystem
+    size_t len = 0;
+    uint8_t* data = hal.fs->readFile(asset.path, len);
+    if (!data) {
+        Serial.print("Icon cache: failed to read ");
+        Serial.println(asset.path);
+        return false;
+    }
+
+    bool ok = true;
+    for (uint8_t b = 0; b < BG_COUNT && ok; b++) {
+        LGFX_Sprite& sprite = sprites[id][b];
+        sprite.setColorDepth(16);
+        if (!sprite.createSprite(asset.size, asset.size)) {
+            ok = false;
+            break;
+        }
+        sprite.fillScreen(THEME_BACKGROUNDS.colors[b]);
+        if (sprite.drawPng(data, len, 0, 0)) {
+            cached[id][b] = true;
+        } else {
+            sprite.deleteSprite();
+            ok = false;
+        }
+    }
+    free(data);
+
+    if (!ok) {
+        Serial.print("Icon cache: failed to decode ");
+        Serial.println(asset.path);
+    }
+    return ok;
+}
+
+bool IconCache::draw(LovyanGFX& target, IconId id, uint16_t bgColor, int16_t x, int16_t y) {
+    int8_t b = bgIndex(bgColor);
+    if (b < 0 || !cached[id][b]) return false;
+
+    uint32_t start = micros();
+    sprites[id][b].pushSprite(&target, x, y);
+    blitTimeUs += micros() - start;
+    blitCount++;
+    return true;
+}
+
+int16_t IconCache::getSize(IconId id) const {
+    return ASSETS[id].size;
+}
+
+int8_t IconCache::bgIndex(uint16_t bgColor) const {
+    for (uint8_t b = 0; b < BG_COUNT; b++) {
+        if (THEME_BACKGROUNDS.colors[b] == bgColor) return b;
+    }
+    return -1;
+}
@@ -0,0 +1,63 @@
+/**
+ * Icon Cache Module
+ * Decodes the PNG icons from storage once at boot and keeps them in RAM
+ */
+
+#ifndef ICON_CACHE_H
+#define ICON_CACHE_H
+
+#include <Arduino.h>
+#include <M5GFX.h>
+#include "config.h"
+#include "Theme.h"
+#include "hal/Hal.h"
+
+// Cached icons
+enum IconId {
+    ICON_TOMATO,
+    ICON_GEAR,
+    ICON_COUNT
+};
+
+class IconCache {
+public:
+    // Constructor
+    IconCache();
+
+    // Decode every icon against every theme background (call after the HAL is installed)
+    bool load();
+
+    // Blit a cached icon; returns false if it is not cached for this background
+    bool draw(LovyanGFX& target, IconId id, uint16_t bgColor, int16_t x, int16_t y);
+
+    // Icon geometry
+    int16_t getSize(IconId id) const;
+
+    // Timing statistics (for performance monitoring)
+    uint32_t getLoadTimeUs() const { return loadTimeUs; }
+    uint32_t getBlitCount() const { return blitCount; }
+    uint32_t getBlitTimeUs() const { return blitTimeUs; }
+    void resetStats() { blitCount = 0; blitTimeUs = 0; }
+
+private:
+    // PNGs have alpha, so each icon is pre-blended over each background in THEME_BACKGROUNDS
+    static const uint8_t BG_COUNT = THEME_BACKGROUNDS.count;
+
+    struct IconAsset {
+        const char* path;
+        int16_t size;
+    };
+    static const IconAsset ASSETS[ICON_COUNT];
+
+    LGFX_Sprite sprites[ICON_COUNT][BG_COUNT];
+    bool cached[ICON_COUNT][BG_COUNT];
+
+    uint32_t loadTimeUs;
+    uint32_t blitCount;
+    uint32_t blitTimeUs;
+
+    bool loadIcon(IconId id);
+    int8_t bgIndex(uint16_t bgColor) const;
+};
+
+#endif // ICON_CACHE_H
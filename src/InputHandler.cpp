@@ -7,16 +7,38 @@
 #include "InputHandler.h"
 
 InputHandler::InputHandler() 
-    : lastEncoderPos(0),
-      buttonPressTime(0),
+    : buttonPressTime(0),
       buttonPressed(false),
       longPressHandled(false),
-      lastEncoderChangeTime(0) {
+      lastActivityTime(0) {
 }
 
 void InputHandler::init() {
-    // Initialize encoder position
-    lastEncoderPos = M5Dial.Encoder.read();
+    // Discard encoder steps queued before the UI was up
+    int8_t step;
+    while (hal.input->popEncoderStep(step)) {
+    }
+}
+
+uint32_t InputHandler::getMsUntilNextEvent() const {
+    uint32_t now = millis();
+    
+    // While the button is held, wake up in time to fire the long press
+    if (buttonPressed && !longPressHandled) {
+        uint32_t held = now - buttonPressTime;
+        return held > LONG_PRESS_MS ? 0 : LONG_PRESS_MS - held + 1;
+    }
+    
+    // The touch interrupt only wakes the loop; the gesture itself is read over
+    // I2C, so poll briskly while one may be in progress (right after any input)
+    if (now - lastActivityTime < INPUT_ACTIVE_WINDOW_MS) {
+        return LOOP_DELAY_ACTIVE;
+    }
+    return UINT32_MAX;
+}
+
+bool InputHandler::isQuiet() const {
+    return !buttonPressed && (millis() - lastActivityTime >= INPUT_ACTIVE_WINDOW_MS);
 }
 
 void InputHandler::processInput(TimerState& currentState,
@@ -49,19 +71,35 @@ void InputHandler::handleEncoderInput(TimerState& currentState,
                                      uint32_t& timerRemaining,
                                      uint32_t& timerDuration,
                                      bool& needsRedraw) {
-    long currentPos = M5Dial.Encoder.read();
-    long delta = currentPos - lastEncoderPos;
-    
-    // Performance optimization: Ignore small changes and debounce
-    if (abs(delta) < ENCODER_THRESHOLD) return;
-    
-    uint32_t now = millis();
-    if (now - lastEncoderChangeTime < ENCODER_DEBOUNCE_MS) return;
+    // Drain every step captured since the last loop, one at a time, in order
+    int8_t step;
+    bool durationChanged = false;
+    bool anyStep = false;
+    while (hal.input->popEncoderStep(step)) {
+        anyStep = true;
+        durationChanged |= applyEncoderStep(step, currentState, settings, settingsMenuIndex,
+                                            settingsEditing, timerRemaining, timerDuration);
+    }
+    if (!anyStep) return;
     
-    lastEncoderPos = currentPos;
-    lastEncoderChangeTime = now;
+    lastActivityTime = millis();
     needsRedraw = true; // Mark that we need to redraw
     
+    if (durationChanged) {
+        // Play click sound when adjusting time (once per batch, not per step)
+        hal.speaker->tone(800, 30); // Short click sound (800 Hz, 30ms)
+    }
+}
+
+bool InputHandler::applyEncoderStep(int8_t step,
+                                    TimerState& currentState,
+                                    PomodoroSettings& settings,
+                                    uint8_t& settingsMenuIndex,
+                                    bool& settingsEditing,
+                                    uint32_t& timerRemaining,
+                                    uint32_t& timerDuration) {
+    int32_t delta = step;
+    
     if (currentState == STATE_SETTINGS) {
         if (settingsEditing) {
             // Adjust current setting value
@@ -95,14 +133,19 @@ void InputHandler::handleEncoderInput(TimerState& currentState,
                 if (newVal < 1) newVal = 1;
                 if (newVal > 6) newVal = 6;
                 settings.brightnessLevel = newVal;
-                M5Dial.Display.setBrightness((settings.brightnessLevel * 255) / 6);
+                hal.display->setBrightness((settings.brightnessLevel * 255) / 6);
+            } else if (settingsMenuIndex == 5) {
+                // Theme (wraps around; the renderer switches on the next frame)
+                int16_t newVal = (settings.themeIndex + delta) % THEME_COUNT;
+                if (newVal < 0) newVal += THEME_COUNT;
+                settings.themeIndex = newVal;
             }
         } else {
             // Navigate menu
             if (delta > 0) {
-                settingsMenuIndex = (settingsMenuIndex + 1) % 6;
+                settingsMenuIndex = (settingsMenuIndex + 1) % SETTINGS_MENU_ROWS;
             } else {
-                settingsMenuIndex = (settingsMenuIndex + 5) % 6;
+                settingsMenuIndex = (settingsMenuIndex + SETTINGS_MENU_ROWS - 1) % SETTINGS_MENU_ROWS;
             }
         }
     } else if (currentState == STATE_IDLE) {
@@ -124,10 +167,10 @@ void InputHandler::handleEncoderInput(TimerState& currentState,
             settings.shortBreakDuration = settings.workDuration / 5;
             settings.longBreakDuration = settings.workDuration;
             
-            // Play click sound when adjusting time
-            M5Dial.Speaker.tone(800, 30); // Short click sound (800 Hz, 30ms)
+            return true;
         }
     }
+    return false;
 }
 
 void InputHandler::handleButtonInput(TimerState& currentState,
@@ -139,16 +182,17 @@ void InputHandler::handleButtonInput(TimerState& currentState,
                                     void (*pauseTimerCallback)(),
                                     void (*resumeTimerCallback)(),
                                     void (*resetTimerCallback)()) {
-    if (M5Dial.BtnA.isPressed()) {
+    if (hal.input->isButtonPressed()) {
         if (!buttonPressed) {
             buttonPressed = true;
             longPressHandled = false;
             buttonPressTime = millis();
+            lastActivityTime = buttonPressTime;
         } else {
             uint32_t pressDuration = millis() - buttonPressTime;
             
             // Check for long press (2+ seconds) = Reset to ready
-            if (pressDuration > 2000 && !longPressHandled) {
+            if (pressDuration > LONG_PRESS_MS && !longPressHandled) {
                 longPressHandled = true;
                 if (currentState == STATE_SETTINGS) {
                     // In settings, long press does nothing
@@ -170,9 +214,10 @@ void InputHandler::handleButtonInput(TimerState& currentState,
     } else {
         if (buttonPressed) {
             buttonPressed = false;
-            uint32_t pressDuration = millis() - buttonPressTime;
+            lastActivityTime = millis();
+            uint32_t pressDuration = lastActivityTime - buttonPressTime;
             // Only handle short press if long press was NOT handled
-            if (pressDuration < 2000 && !longPressHandled) {
+            if (pressDuration < LONG_PRESS_MS && !longPressHandled) {
                 // Short press (< 2 seconds) = normal actions
                 handleButtonPress(currentState, settings, settingsMenuIndex, settingsEditing,
                                 needsRedraw, startTimerCallback, pauseTimerCallback, 
@@ -186,18 +231,17 @@ void InputHandler::handleTouchInput(TimerState& currentState,
                                    uint8_t& settingsMenuIndex,
                                    bool& settingsEditing,
                                    bool& needsRedraw) {
-    auto touch = M5Dial.Touch.getDetail();
-    if (touch.wasPressed()) {
-        int16_t touchX = touch.x;
-        int16_t touchY = touch.y;
+    int16_t touchX, touchY;
+    if (hal.input->getTouchPress(touchX, touchY)) {
+        lastActivityTime = millis();
         
         // Check if touch is in the gear icon area (bottom center)
         // Increased touch area for better responsiveness: 40x40 pixel area
         // Gear is at bottom: x = CENTER_X-20 to CENTER_X+20, y = SCREEN_HEIGHT-45 to SCREEN_HEIGHT
         if (touchX >= CENTER_X - 20 && touchX <= CENTER_X + 20 &&
             touchY >= SCREEN_HEIGHT - 45 && touchY <= SCREEN_HEIGHT) {
-            // Touch on gear icon = open settings
-            if (currentState != STATE_SETTINGS) {
+            // Touch on gear icon = open settings (the statistics screen has no gear)
+            if (currentState != STATE_SETTINGS && currentState != STATE_STATS) {
                 currentState = STATE_SETTINGS;
                 settingsMenuIndex = 0;
                 settingsEditing = false;
@@ -205,6 +249,14 @@ void InputHandler::handleTouchInput(TimerState& currentState,
                 Serial.println("Opening Settings (gear icon touched)");
             }
         }
+        
+        // Touch on the pomodoro counter or tomato (top center) while Ready = open statistics
+        if (touchX >= CENTER_X - 60 && touchX <= CENTER_X + 60 &&
+            touchY >= 0 && touchY <= 80 && currentState == STATE_IDLE) {
+            currentState = STATE_STATS;
+            needsRedraw = true;
+            Serial.println("Opening Statistics (counter touched)");
+        }
     }
 }
 
@@ -244,20 +296,29 @@ void InputHandler::handleButtonPress(TimerState& currentState,
             break;
             
         case STATE_SETTINGS:
-            if (settingsMenuIndex == 5) {
-                // Back to main screen - force full screen clear to prevent overlap
-                uint16_t bgColor = COLOR_WORK_BG; // Red background for idle
-                M5Dial.Display.fillScreen(bgColor);
+            if (settingsMenuIndex == SETTINGS_MENU_ROWS - 1) {
+                // Back to main screen (the renderer repaints the whole screen
+                // when leaving settings)
                 currentState = STATE_IDLE;
                 if (resetTimerCallback) {
                     resetTimerCallback();
                 }
                 needsRedraw = true;
                 Serial.println("Exiting Settings -> Idle");
-            } else if (settingsMenuIndex >= 0 && settingsMenuIndex <= 4) {
-                // Allow editing all settings: Work Duration, Short Break, Long Break, Pomodoros/Long, Brightness
+            } else {
+                // Allow editing all settings: Work Duration, Short Break, Long Break, Pomodoros/Long,
+                // Brightness, Theme
                 settingsEditing = !settingsEditing;
             }
             break;
+            
+        case STATE_STATS:
+            // Back to main screen (nothing was running while the statistics were open)
+            currentState = STATE_IDLE;
+            if (resetTimerCallback) {
+                resetTimerCallback();
+            }
+            Serial.println("Exiting Statistics -> Idle");
+            break;
     }
 }
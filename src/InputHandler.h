@@ -7,18 +7,34 @@
 #define INPUT_HANDLER_H
 
 #include <Arduino.h>
-#include <M5Dial.h>
+#include <M5GFX.h>
 #include "config.h"
+#include "hal/Hal.h"
 #include "types.h"
+#include "Theme.h"
 
 class InputHandler {
 public:
+    static constexpr uint32_t LONG_PRESS_MS = 2000;       // Hold time for reset
+
     // Constructor
     InputHandler();
     
     // Initialize input handler
     void init();
     
+    // Milliseconds until input needs polling again (long-press threshold, active window)
+    uint32_t getMsUntilNextEvent() const;
+    
+    // Record input activity seen outside processInput (e.g. a wake-up interrupt)
+    void noteActivity() { lastActivityTime = millis(); }
+    
+    // True when no press is held and the post-input poll window has passed
+    bool isQuiet() const;
+    
+    // Encoder steps lost to a full capture queue (for performance monitoring)
+    uint32_t getEncoderDropped() const { return hal.input->getDroppedSteps(); }
+    
     // Main input processing function (call from loop)
     void processInput(TimerState& currentState, 
                      PomodoroSettings& settings,
@@ -34,15 +50,10 @@ public:
     
 private:
     // Input state tracking
-    long lastEncoderPos;
     uint32_t buttonPressTime;
     bool buttonPressed;
     bool longPressHandled;
-    
-    // Performance optimization - encoder debouncing
-    uint32_t lastEncoderChangeTime;
-    static constexpr uint32_t ENCODER_DEBOUNCE_MS = 10;  // Balanced for smoothness and responsiveness
-    static constexpr int32_t ENCODER_THRESHOLD = 1;       // Minimum encoder delta to process
+    uint32_t lastActivityTime;
     
     // Internal handlers
     void handleEncoderInput(TimerState& currentState,
@@ -53,6 +64,15 @@ private:
                            uint32_t& timerDuration,
                            bool& needsRedraw);
     
+    // Apply a single encoder step; returns true if the idle duration changed
+    bool applyEncoderStep(int8_t step,
+                          TimerState& currentState,
+                          PomodoroSettings& settings,
+                          uint8_t& settingsMenuIndex,
+                          bool& settingsEditing,
+                          uint32_t& timerRemaining,
+                          uint32_t& timerDuration);
+    
     void handleButtonInput(TimerState& currentState,
                           PomodoroSettings& settings,
                           uint8_t& settingsMenuIndex,
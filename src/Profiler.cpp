@@ -0,0 +1,104 @@
+/**
+ * Loop Profiler Implementation
+ */
+
+#include "Profiler.h"
+
+#if ENABLE_PERFORMANCE_MONITOR
+
+#ifndef ARDUINO_ARCH_ESP32
+#include <chrono>
+uint32_t profilerTicks() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+Profiler profiler;
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "control",
+    "input_update",
+    "process_input",
+    "timer_update",
+    "checkpoint",
+    "storage",
+    "ui_bind",
+    "draw_timer",
+    "draw_settings",
+    "draw_stats",
+    "flush"
+};
+
+Profiler::Profiler() {
+    reset();
+}
+
+void Profiler::reset() {
+    memset(histograms, 0, sizeof(histograms));
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        histograms[i].min = UINT32_MAX;
+    }
+}
+
+uint8_t Profiler::bucketFor(uint32_t ticks) {
+    if (ticks < SUB_BUCKETS) return ticks;
+    // Power of two picks the group, the next SUB_BUCKET_BITS bits pick the bucket in it
+    uint8_t exponent = 31 - __builtin_clz(ticks);
+    uint8_t mantissa = (ticks >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + mantissa;
+}
+
+uint32_t Profiler::bucketUpperBound(uint8_t bucket) {
+    if (bucket + 1 >= BUCKET_COUNT) return UINT32_MAX;
+    uint8_t next = bucket + 1;
+    if (next < SUB_BUCKETS) return next - 1;
+    uint8_t exponent = (next - SUB_BUCKETS) / SUB_BUCKETS + SUB_BUCKET_BITS;
+    uint8_t mantissa = (next - SUB_BUCKETS) % SUB_BUCKETS;
+    return ((uint32_t)(SUB_BUCKETS + mantissa) << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+void Profiler::record(ProfilePhase phase, uint32_t ticks) {
+    Histogram& h = histograms[phase];
+    h.buckets[bucketFor(ticks)]++;
+    h.count++;
+    h.total += ticks;
+    if (ticks < h.min) h.min = ticks;
+    if (ticks > h.max) h.max = ticks;
+}
+
+uint32_t Profiler::percentile(const Histogram& h, uint8_t percent) {
+    // Smallest bucket holding the requested share of samples; reported as its
+    // upper bound, clamped to the exact extremes
+    uint32_t target = (h.count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += h.buckets[i];
+        if (seen >= target) {
+            uint32_t value = bucketUpperBound(i);
+            if (value > h.max) value = h.max;
+            if (value < h.min) value = h.min;
+            return value;
+        }
+    }
+    return h.max;
+}
+
+void Profiler::report(uint32_t intervalMs) {
+    Serial.print("PROF_BEGIN,"); Serial.print(intervalMs);
+    Serial.print(","); Serial.println(profilerTicksPerUs());
+    for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+        const Histogram& h = histograms[i];
+        if (h.count == 0) continue;
+        Serial.print("PROF,"); Serial.print(PHASE_NAMES[i]);
+        Serial.print(","); Serial.print(h.count);
+        Serial.print(","); Serial.print(h.min);
+        Serial.print(","); Serial.print(percentile(h, 50));
+        Serial.print(","); Serial.print(percentile(h, 99));
+        Serial.print(","); Serial.print(h.max);
+        Serial.print(","); Serial.println(h.total);
+    }
+    Serial.println("PROF_END");
+}
+
+#endif // ENABLE_PERFORMANCE_MONITOR
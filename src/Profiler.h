@@ -0,0 +1,96 @@
+/**
+ * Loop Profiler
+ * Times each phase of the loop with the CPU cycle counter and keeps a
+ * log-linear histogram per phase, reported over Serial as CSV lines.
+ * Compiles out completely unless ENABLE_PERFORMANCE_MONITOR is 1.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Loop phases, in report order
+enum ProfilePhase {
+    PHASE_CONTROL,          // PomodoroApp::stepControl (everything but rendering and flash writes)
+    PHASE_INPUT_UPDATE,     // hal.input->update (M5Dial.update on device)
+    PHASE_PROCESS_INPUT,    // InputHandler::processInput
+    PHASE_TIMER_UPDATE,     // TimerManager::update
+    PHASE_CHECKPOINT,       // SessionCheckpoint::update
+    PHASE_STORAGE,          // PomodoroApp::stepStorage (journal and history flash writes)
+    PHASE_UI_BIND,          // Screen::bind (frame values into the widgets)
+    PHASE_DRAW_TIMER,       // Dirty widgets of TimerScreen
+    PHASE_DRAW_SETTINGS,    // Dirty widgets of SettingsScreen
+    PHASE_DRAW_STATS,       // Dirty widgets of StatsScreen
+    PHASE_FLUSH,            // Display::flush
+    PHASE_COUNT
+};
+
+#if ENABLE_PERFORMANCE_MONITOR
+
+// Cycle counter: CCOUNT on the ESP32-S3, a nanosecond clock on the host
+#ifdef ARDUINO_ARCH_ESP32
+static inline uint32_t profilerTicks() { return ESP.getCycleCount(); }
+static inline uint32_t profilerTicksPerUs() { return ESP.getCpuFreqMHz(); }
+#else
+uint32_t profilerTicks();
+static inline uint32_t profilerTicksPerUs() { return 1000; }
+#endif
+
+class Profiler {
+public:
+    Profiler();
+
+    void record(ProfilePhase phase, uint32_t ticks);
+
+    // Print every phase as CSV, all values in ticks:
+    //   PROF_BEGIN,<interval_ms>,<ticks_per_us>
+    //   PROF,<phase>,<count>,<min>,<p50>,<p99>,<max>,<total>
+    //   PROF_END
+    void report(uint32_t intervalMs);
+    void reset();
+
+private:
+    // 4 buckets per power of two (<= 25% error), covering the full uint32_t range
+    static const uint8_t SUB_BUCKET_BITS = 2;
+    static const uint8_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const uint8_t BUCKET_COUNT = SUB_BUCKETS + (32 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    struct Histogram {
+        uint32_t buckets[BUCKET_COUNT];
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t total;
+    };
+
+    Histogram histograms[PHASE_COUNT];
+
+    static uint8_t bucketFor(uint32_t ticks);
+    static uint32_t bucketUpperBound(uint8_t bucket);
+    static uint32_t percentile(const Histogram& h, uint8_t percent);
+};
+
+extern Profiler profiler;
+
+// Times the enclosing block
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase) : phase(phase), start(profilerTicks()) {}
+    ~ProfileScope() { profiler.record(phase, profilerTicks() - start); }
+
+private:
+    ProfilePhase phase;
+    uint32_t start;
+};
+
+#define PROFILE_SCOPE(phase) ProfileScope profileScope(phase)
+
+#else
+
+#define PROFILE_SCOPE(phase) do {} while (0)
+
+#endif // ENABLE_PERFORMANCE_MONITOR
+
+#endif // PROFILER_H
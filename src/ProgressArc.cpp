@@ -0,0 +1,155 @@
+/**
+ * Progress Arc Implementation
+ * The span table is built once; a frame is a walk over the swept steps' spans
+ */
+
+#include "ProgressArc.h"
+#include "FixedTrig.h"
+
+ProgressArc::ProgressArc()
+    : spans(nullptr),
+      spanCount(0),
+      pixelCount(0) {
+    memset(stepStart, 0, sizeof(stepStart));
+}
+
+ProgressArc::~ProgressArc() {
+    free(spans);
+}
+
+bool ProgressArc::build() {
+    if (spans) return true;
+
+    // Pass 1: count spans per step, then turn the counts into start offsets
+    memset(stepStart, 0, sizeof(stepStart));
+    pixelCount = 0;
+    scan(nullptr);
+    for (uint16_t s = 0; s < PROGRESS_ARC_STEPS; s++) {
+        stepStart[s + 1] += stepStart[s];
+    }
+    spanCount = stepStart[PROGRESS_ARC_STEPS];
+
+    // Pass 2: place each span at its step's cursor (stepStart doubles as the cursor)
+    Span* table = (Span*)malloc((size_t)spanCount * sizeof(Span));
+    if (!table) {
+        Serial.println("Display: not enough RAM for the progress arc");
+        return false;
+    }
+    spans = table;
+    scan(stepStart);
+    for (uint16_t s = PROGRESS_ARC_STEPS; s > 0; s--) {
+        stepStart[s] = stepStart[s - 1];    // Each cursor ended at the next step's start
+    }
+    stepStart[0] = 0;
+    return true;
+}
+
+void ProgressArc::scan(uint16_t* cursor) {
+    for (int16_t dy = -OUTER - 1; dy <= OUTER + 1; dy++) {
+        int16_t runStep = -1;
+        int16_t runDx = 0;
+        uint8_t runLength = 0;
+        for (int16_t dx = -OUTER - 1; dx <= OUTER + 1; dx++) {
+            uint8_t coverage = coverageAt(dx, dy);
+            int16_t step = coverage ? stepAt(dx, dy) : -1;
+
+            // Opaque pixels of the same step merge into one run
+            if (runLength > 0 && coverage == FULL_COVERAGE && step == runStep && runLength < 255) {
+                runLength++;
+                continue;
+            }
+            if (runLength > 0) {
+                addSpan(cursor, runStep, { (int8_t)runDx, (int8_t)dy, runLength, FULL_COVERAGE });
+                runLength = 0;
+            }
+            if (step < 0) continue;
+
+            if (coverage == FULL_COVERAGE) {
+                runStep = step;
+                runDx = dx;
+                runLength = 1;
+            } else {
+                // Edge pixels are runs of one, each with its own coverage
+                addSpan(cursor, step, { (int8_t)dx, (int8_t)dy, 1, coverage });
+            }
+        }
+        if (runLength > 0) {
+            addSpan(cursor, runStep, { (int8_t)runDx, (int8_t)dy, runLength, FULL_COVERAGE });
+        }
+    }
+}
+
+void ProgressArc::addSpan(uint16_t* cursor, int16_t step, const Span& span) {
+    if (cursor) {
+        spans[cursor[step]++] = span;
+    } else {
+        stepStart[step + 1]++;
+        pixelCount += span.length;
+    }
+}
+
+uint8_t ProgressArc::coverageAt(int16_t dx, int16_t dy) {
+    // Quick reject well outside the band
+    int32_t r2 = (int32_t)dx * dx + (int32_t)dy * dy;
+    if (r2 > (int32_t)(OUTER + 1) * (OUTER + 1) || r2 < (int32_t)(INNER - 1) * (INNER - 1)) return 0;
+
+    // 4x4 samples at (d + (2i + 1) / 8 - 1/2), in eighths of a pixel so it stays integer
+    const int32_t inner2 = 64 * (int32_t)INNER * INNER;
+    const int32_t outer2 = 64 * (int32_t)OUTER * OUTER;
+    uint8_t inside = 0;
+    for (int8_t j = 0; j < 4; j++) {
+        int32_t sy = 8 * dy + 2 * j - 3;
+        for (int8_t i = 0; i < 4; i++) {
+            int32_t sx = 8 * dx + 2 * i - 3;
+            int32_t s2 = sx * sx + sy * sy;
+            if (s2 >= inner2 && s2 < outer2) inside++;
+        }
+    }
+    return inside;
+}
+
+int16_t ProgressArc::stepAt(int16_t dx, int16_t dy) {
+    // Clockwise from 12 o'clock; the sweep is centered on the top of the ring.
+    // Distance along the sweep in degrees * FINE_ANGLE_TURN keeps it integer.
+    const int64_t turn = 360LL * FINE_ANGLE_TURN;
+    const int64_t sweep = (int64_t)PROGRESS_ARC_SWEEP_DEG * FINE_ANGLE_TURN;
+    int64_t along = ((int64_t)screenAngle(dx, dy) * 360 + sweep / 2) % turn;
+    if (along >= sweep) return -1;
+    return (int16_t)(along * PROGRESS_ARC_STEPS / sweep);
+}
+
+uint16_t ProgressArc::blend(uint16_t color, uint16_t bgColor, uint8_t coverage) {
+    uint8_t rest = FULL_COVERAGE - coverage;
+    uint16_t r = (((color >> 11) & 0x1F) * coverage + ((bgColor >> 11) & 0x1F) * rest) / FULL_COVERAGE;
+    uint16_t g = (((color >> 5) & 0x3F) * coverage + ((bgColor >> 5) & 0x3F) * rest) / FULL_COVERAGE;
+    uint16_t b = ((color & 0x1F) * coverage + (bgColor & 0x1F) * rest) / FULL_COVERAGE;
+    return (r << 11) | (g << 5) | b;
+}
+
+uint32_t ProgressArc::draw(LovyanGFX& target, uint16_t fromStep, uint16_t toStep,
+                           uint16_t color, uint16_t bgColor,
+                           int16_t& x0, int16_t& y0, int16_t& x1, int16_t& y1) {
+    if (!spans) return 0;
+    if (toStep > PROGRESS_ARC_STEPS) toStep = PROGRESS_ARC_STEPS;
+    if (fromStep >= toStep) return 0;
+
+    uint32_t pixels = 0;
+    for (uint16_t i = stepStart[fromStep]; i < stepStart[toStep]; i++) {
+        const Span& span = spans[i];
+        int16_t x = CENTER_X + span.dx;
+        int16_t y = CENTER_Y + span.dy;
+        uint16_t spanColor = span.coverage == FULL_COVERAGE ? color : blend(color, bgColor, span.coverage);
+        if (span.length == 1) {
+            target.drawPixel(x, y, spanColor);
+        } else {
+            target.drawFastHLine(x, y, span.length, spanColor);
+        }
+        pixels += span.length;
+
+        if (x < x0) x0 = x;
+        if (y < y0) y0 = y;
+        if (x + span.length > x1) x1 = x + span.length;
+        if (y + 1 > y1) y1 = y + 1;
+    }
+    return pixels;
+}
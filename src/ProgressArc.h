@@ -0,0 +1,64 @@
+/**
+ * Progress Arc Module
+ * The ring around the countdown as a gauge of PROGRESS_ARC_STEPS angular
+ * steps. Every pixel of the annulus is assigned to the step its center falls
+ * in, and each step keeps its pixels as horizontal spans, so advancing the
+ * arc rasterizes only the newly swept wedge. Pixels on the inner and outer
+ * edge carry their coverage and are blended with the background.
+ */
+
+#ifndef PROGRESS_ARC_H
+#define PROGRESS_ARC_H
+
+#include <Arduino.h>
+#include <M5GFX.h>
+#include "config.h"
+
+class ProgressArc {
+public:
+    // Constructor
+    ProgressArc();
+    ~ProgressArc();
+
+    // Build the span table (call once; false if it could not be allocated)
+    bool build();
+    bool isBuilt() const { return spans != nullptr; }
+
+    // Paint steps [fromStep, toStep) in color over bgColor; returns the pixels
+    // written and grows x0,y0 - x1,y1 (exclusive) to cover them
+    uint32_t draw(LovyanGFX& target, uint16_t fromStep, uint16_t toStep,
+                  uint16_t color, uint16_t bgColor,
+                  int16_t& x0, int16_t& y0, int16_t& x1, int16_t& y1);
+
+    // Table size (for performance monitoring)
+    uint16_t getSpanCount() const { return spanCount; }
+    uint16_t getPixelCount() const { return pixelCount; }
+
+private:
+    static const int16_t OUTER = CIRCLE_RADIUS + CIRCLE_THICKNESS / 2;
+    static const int16_t INNER = CIRCLE_RADIUS - CIRCLE_THICKNESS / 2;
+    static const uint8_t FULL_COVERAGE = 16;    // 4x4 samples per pixel
+
+    // One horizontal run of pixels, relative to the ring center
+    struct Span {
+        int8_t dx;
+        int8_t dy;
+        uint8_t length;
+        uint8_t coverage;       // Samples inside the annulus (FULL_COVERAGE = opaque)
+    };
+
+    // Spans of step s are spans[stepStart[s]] .. spans[stepStart[s + 1] - 1]
+    uint16_t stepStart[PROGRESS_ARC_STEPS + 1];
+    Span* spans;
+    uint16_t spanCount;
+    uint16_t pixelCount;
+
+    // Walk the annulus; counts spans per step, or places them when spans is allocated
+    void scan(uint16_t* cursor);
+    void addSpan(uint16_t* cursor, int16_t step, const Span& span);
+    static uint8_t coverageAt(int16_t dx, int16_t dy);
+    static int16_t stepAt(int16_t dx, int16_t dy);     // -1 = in the gap
+    static uint16_t blend(uint16_t color, uint16_t bgColor, uint8_t coverage);
+};
+
+#endif // PROGRESS_ARC_H
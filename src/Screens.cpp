@@ -0,0 +1,176 @@
+/**
+ * UI Screens Implementation
+ * bind() runs every frame, so it only formats text; painting is left to
+ * the widgets that changed
+ */
+
+#include "Screens.h"
+#include "Display.h"
+
+// ==================== SCREEN ====================
+Screen::Screen(ProfilePhase phase)
+    : background(0),
+      first(nullptr),
+      last(nullptr),
+      phase(phase) {
+}
+
+void Screen::add(Widget& widget) {
+    widget.next = nullptr;
+    if (last) last->next = &widget;
+    else first = &widget;
+    last = &widget;
+}
+
+void Screen::invalidate() {
+    for (Widget* w = first; w; w = w->next) w->invalidate();
+}
+
+// ==================== TIMER ====================
+TimerScreen::TimerScreen()
+    : Screen(PHASE_DRAW_TIMER),
+      tomato(LAYOUT.tomato, ICON_TOMATO, TOMATO_SIZE, nullptr, COLOR_WORK),
+      arc(),
+      time(LAYOUT.time),
+      status(LAYOUT.status),
+      instruction(LAYOUT.instruction),
+      gear(LAYOUT.gear, ICON_GEAR, GEAR_SIZE, "\xE2\x9A\x99", COLOR_TEXT),
+      counter(LAYOUT.counter) {
+    add(tomato);
+    if (SHOW_PROGRESS_ARC) add(arc);
+    add(time);
+    add(status);
+    add(instruction);
+    add(gear);
+    add(counter);
+}
+
+void TimerScreen::bind(const DisplaySnapshot& frame, const Theme& theme) {
+    const StateStyle& style = theme.states[frame.state];
+    const StateLabels& labels = STATE_LABELS[frame.state];
+    background = style.background;
+
+    char pomoText[25];
+    snprintf(pomoText, sizeof(pomoText), "Pomodoros: %d", frame.completedPomodoros);
+
+    tomato.set(theme.text, background);
+    arc.set(frame.arcStep, style.arc, theme.track, background);
+    time.set(frame.remaining, theme.text, background);
+    status.set(labels.status, theme.text, background);
+    instruction.set(labels.instruction, theme.text, background);
+    gear.set(theme.text, background);
+    counter.set(pomoText, theme.text, background);
+}
+
+// ==================== SETTINGS ====================
+SettingsScreen::SettingsScreen()
+    : Screen(PHASE_DRAW_SETTINGS),
+      title(LAYOUT.title),
+      rows(LAYOUT.settings, SETTINGS_MENU_ROWS),
+      footer(LAYOUT.settingsFooter, LAYOUT.footerPitch) {
+    add(title);
+    add(rows);
+    add(footer);
+}
+
+void SettingsScreen::bind(const DisplaySnapshot& frame, const Theme& theme) {
+    static const char* const MENU_LABELS[SETTINGS_MENU_ROWS] = {
+        "Work Duration: ",
+        "Short Break: ",
+        "Long Break: ",
+        "Pomodoros/Long: ",
+        "Brightness: ",
+        "Theme: ",
+        "Back"
+    };
+    const PomodoroSettings& settings = frame.settings;
+    background = theme.listBackground;
+
+    title.set("Settings", theme.text, background);
+
+    for (uint8_t i = 0; i < SETTINGS_MENU_ROWS; i++) {
+        char value[Display::TIME_TEXT_SIZE];
+        if (i == 0) {
+            // Work Duration - editable
+            Display::formatTime(settings.workDuration, value, sizeof(value));
+        } else if (i == 1) {
+            // Short Break - editable
+            Display::formatTime(settings.shortBreakDuration, value, sizeof(value));
+        } else if (i == 2) {
+            // Long Break - editable
+            Display::formatTime(settings.longBreakDuration, value, sizeof(value));
+        } else if (i == 3) {
+            // Pomodoros until long break - editable
+            snprintf(value, sizeof(value), "%d", settings.pomodorosUntilLongBreak);
+        } else if (i == 4) {
+            // Brightness level - editable
+            snprintf(value, sizeof(value), "Level %d/6", settings.brightnessLevel);
+        } else if (i == 5) {
+            // Theme - editable, applied live
+            snprintf(value, sizeof(value), "%s", THEMES[settings.themeIndex % THEME_COUNT].name);
+        } else {
+            // Back
+            value[0] = '\0';
+        }
+
+        // Navigating repaints the old and new highlighted rows; editing only the value field
+        bool selected = (i == frame.settingsMenuIndex);
+        rows.setRow(i, MENU_LABELS[i], value,
+                    selected ? theme.highlightText : theme.text,
+                    selected ? theme.highlightBackground : background);
+    }
+
+    footer.set("Dial: Navigate/Adjust\nPress: Select/Edit", theme.text, background);
+}
+
+// ==================== STATISTICS ====================
+StatsScreen::StatsScreen()
+    : Screen(PHASE_DRAW_STATS),
+      title(LAYOUT.title),
+      rows(LAYOUT.stats, STATS_ROWS),
+      footer(LAYOUT.statsFooter) {
+    add(title);
+    add(rows);
+    add(footer);
+}
+
+void StatsScreen::bind(const DisplaySnapshot& frame, const Theme& theme) {
+    const StatsSummary& stats = frame.stats;
+    background = theme.listBackground;
+
+    title.set("Statistics", theme.text, background);
+
+    // Calendar figures need the RTC; without it only the lifetime totals mean anything
+    char today[Display::TIME_TEXT_SIZE], week[Display::TIME_TEXT_SIZE];
+    char month[Display::TIME_TEXT_SIZE], average[Display::TIME_TEXT_SIZE];
+    char streak[24], sessions[12];
+    snprintf(streak, sizeof(streak), "%u days (best %u)", stats.streakDays, stats.bestStreakDays);
+    snprintf(sessions, sizeof(sessions), "%lu", (unsigned long)stats.focusSessions);
+
+    rows.setRow(0, "Today: ",
+                stats.wallClock ? Display::formatHours(stats.todaySeconds, today, sizeof(today)) : "--",
+                theme.text, background);
+    rows.setRow(1, "This Week: ",
+                stats.wallClock ? Display::formatHours(stats.weekSeconds, week, sizeof(week)) : "--",
+                theme.text, background);
+    rows.setRow(2, "This Month: ",
+                stats.wallClock ? Display::formatHours(stats.monthSeconds, month, sizeof(month)) : "--",
+                theme.text, background);
+    rows.setRow(3, "Streak: ", streak, theme.text, background);
+    rows.setRow(4, "Sessions: ", sessions, theme.text, background);
+    rows.setRow(5, "Average: ", Display::formatTime(stats.averageSeconds, average, sizeof(average)),
+                theme.text, background);
+
+    footer.set("Press: Back", theme.text, background);
+}
+
+// ==================== SCREEN SET ====================
+ScreenSet::ScreenSet() {
+    byState[STATE_IDLE] = &timer;
+    byState[STATE_RUNNING] = &timer;
+    byState[STATE_PAUSED] = &timer;
+    byState[STATE_SHORT_BREAK] = &timer;
+    byState[STATE_LONG_BREAK] = &timer;
+    byState[STATE_SETTINGS] = &settings;
+    byState[STATE_STATS] = &stats;
+}
@@ -0,0 +1,96 @@
+/**
+ * UI Screens
+ * Each screen is a chain of widgets plus a bind() that copies a published
+ * frame into them. The renderer picks the screen for the frame's state from
+ * ScreenSet, binds it and paints its dirty widgets; a new screen is a Screen
+ * subclass and an entry in the ScreenSet table, not a change to the loop.
+ */
+
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "types.h"
+#include "Theme.h"
+#include "Widget.h"
+#include "Profiler.h"
+
+class Screen {
+public:
+    explicit Screen(ProfilePhase phase);
+    virtual ~Screen() {}
+
+    // Copy the frame's values into the widgets; the ones that changed turn dirty
+    virtual void bind(const DisplaySnapshot& frame, const Theme& theme) = 0;
+
+    // Mark every widget dirty (the screen was cleared)
+    void invalidate();
+
+    Widget* getWidgets() const { return first; }    // In paint order
+    uint16_t getBackground() const { return background; }
+    ProfilePhase getPhase() const { return phase; }
+
+protected:
+    uint16_t background;        // Set by bind()
+
+    void add(Widget& widget);
+
+private:
+    Widget* first;
+    Widget* last;
+    ProfilePhase phase;
+};
+
+// Countdown, progress ring, status and hints (Ready, Focusing, Paused, breaks)
+class TimerScreen : public Screen {
+public:
+    TimerScreen();
+    void bind(const DisplaySnapshot& frame, const Theme& theme) override;
+
+private:
+    IconWidget tomato;
+    ArcWidget arc;
+    CountdownWidget time;
+    LabelWidget status;
+    LabelWidget instruction;
+    IconWidget gear;
+    LabelWidget counter;
+};
+
+class SettingsScreen : public Screen {
+public:
+    SettingsScreen();
+    void bind(const DisplaySnapshot& frame, const Theme& theme) override;
+
+private:
+    LabelWidget title;
+    ListWidget rows;
+    LabelWidget footer;
+};
+
+class StatsScreen : public Screen {
+public:
+    StatsScreen();
+    void bind(const DisplaySnapshot& frame, const Theme& theme) override;
+
+private:
+    LabelWidget title;
+    ListWidget rows;
+    LabelWidget footer;
+};
+
+// The screen shown in each TimerState
+class ScreenSet {
+public:
+    ScreenSet();
+    Screen& forState(TimerState state) { return *byState[state]; }
+
+private:
+    TimerScreen timer;
+    SettingsScreen settings;
+    StatsScreen stats;
+    Screen* byState[STATE_COUNT];
+};
+
+#endif // SCREENS_H
@@ -0,0 +1,223 @@
+/**
+ * Session Checkpoint Implementation
+ */
+
+#include "SessionCheckpoint.h"
+#include "Crc32.h"
+#include "Trace.h"
+
+SessionCheckpoint::SessionCheckpoint()
+    : sequence(1),
+      nextSlot(0),
+      slotCount(0),
+      wallAtBoot(0),
+      bootMs(0),
+      lastFlashElapsedMs(0),
+      lastUpdateMs(0),
+      journalQueued(0),
+      journalServiced(0),
+      journalSequence(0),
+      rtcWrites(0),
+      costUs(0),
+      countingMs(0),
+      flashWrites(0),
+      flashErases(0),
+      journalCostUs(0),
+      journalStatsReset(false) {
+    memset(&last, 0, sizeof(last));
+}
+
+bool SessionCheckpoint::isCounting(uint8_t state) {
+    return state == STATE_RUNNING || state == STATE_SHORT_BREAK || state == STATE_LONG_BREAK;
+}
+
+bool SessionCheckpoint::isWallValid(uint32_t seconds) {
+    return seconds >= WALL_CLOCK_MIN_VALID;     // Also rejects 0 (no wall clock)
+}
+
+bool SessionCheckpoint::isValid(const Record& record) {
+    return record.magic == MAGIC && record.crc == crc32(&record, offsetof(Record, crc));
+}
+
+bool SessionCheckpoint::begin(SessionSnapshot& session, uint32_t& downtimeMs) {
+    bootMs = millis();
+    lastUpdateMs = bootMs;
+    wallAtBoot = hal.clock->wallSeconds();
+    if (!isWallValid(wallAtBoot)) wallAtBoot = 0;   // Records then carry no wall time either
+    slotCount = (hal.journal->size() / FLASH_SECTOR_SIZE) * RECORDS_PER_SECTOR;
+    downtimeMs = 0;
+
+    Record rtc;
+    Record journal;
+    bool haveRtc = loadRtc(rtc);
+    bool haveJournal = scanJournal(journal);
+    if (!haveRtc && !haveJournal) return false;
+
+    // Both tiers share one sequence: the higher number is the later checkpoint
+    const Record& newest = (haveRtc && (!haveJournal || rtc.sequence >= journal.sequence)) ? rtc : journal;
+    sequence = newest.sequence + 1;
+    last = newest.session;
+    lastFlashElapsedMs = newest.session.elapsedMs;
+    session = newest.session;
+    if (!isCounting(session.state) && session.state != STATE_PAUSED) return false;
+
+    // Downtime is only known if the wall clock was valid at both ends and kept
+    // running while we were off
+    bool wallKnown = isWallValid(newest.wallSeconds) && isWallValid(wallAtBoot) &&
+                     wallAtBoot >= newest.wallSeconds;
+    uint32_t downtimeS = wallKnown ? wallAtBoot - newest.wallSeconds : 0;
+    if (downtimeS > RESUME_MAX_DOWNTIME_S) {
+        Serial.println("Checkpoint: interrupted session too old - not resuming");
+        return false;
+    }
+    if (isCounting(session.state)) {
+        if (wallKnown) {
+            downtimeMs = downtimeS * 1000UL;
+        } else {
+            // No idea how long we were off: resume paused instead of guessing
+            session.stateBeforePause = session.state;
+            session.state = STATE_PAUSED;
+        }
+    }
+
+    Serial.print("Checkpoint: resuming session from ");
+    Serial.print(haveRtc && &newest == &rtc ? "RTC memory" : "flash journal");
+    Serial.print(", off for ");
+    Serial.print(wallKnown ? (long)downtimeS : -1L);
+    Serial.println(" s");
+    return true;
+}
+
+bool SessionCheckpoint::update(const SessionSnapshot& session) {
+    uint32_t now = millis();
+    if (isCounting(last.state)) countingMs += now - lastUpdateMs;
+    lastUpdateMs = now;
+
+    // State changes go to both tiers; while counting, RTC memory follows every
+    // second and the journal every minute of session time
+    bool changed = session.state != last.state ||
+                   session.duration != last.duration ||
+                   session.completedPomodoros != last.completedPomodoros;
+    bool counting = isCounting(session.state);
+    bool rtcDue = changed ||
+                  (counting && session.elapsedMs / CHECKPOINT_RTC_INTERVAL_MS !=
+                               last.elapsedMs / CHECKPOINT_RTC_INTERVAL_MS);
+    bool flashDue = changed ||
+                    (counting && session.elapsedMs - lastFlashElapsedMs >= CHECKPOINT_FLASH_INTERVAL_MS);
+    if (!rtcDue) return false;
+
+    uint32_t start = micros();
+    Record record;
+    makeRecord(session, record);
+    writeRtc(record);
+    if (flashDue) {
+        journalRecords.publish(record);
+        __atomic_store_n(&journalQueued, journalQueued + 1, __ATOMIC_RELEASE);
+        lastFlashElapsedMs = session.elapsedMs;
+    }
+    costUs += micros() - start;
+    last = session;
+    return flashDue;
+}
+
+void SessionCheckpoint::service() {
+    if (__atomic_exchange_n(&journalStatsReset, false, __ATOMIC_ACQ_REL)) {
+        flashWrites = 0;
+        flashErases = 0;
+        journalCostUs = 0;
+    }
+    uint32_t queued = __atomic_load_n(&journalQueued, __ATOMIC_ACQUIRE);
+    if (queued == journalServiced) return;
+
+    uint32_t start = micros();
+    Record record;
+    uint32_t sequence = journalRecords.read(record);
+    if (sequence != journalSequence) {
+        appendJournal(record);
+        journalSequence = sequence;
+    }
+    journalCostUs += micros() - start;
+    __atomic_store_n(&journalServiced, queued, __ATOMIC_RELEASE);
+}
+
+bool SessionCheckpoint::isJournalPending() const {
+    return __atomic_load_n(&journalQueued, __ATOMIC_ACQUIRE) !=
+           __atomic_load_n(&journalServiced, __ATOMIC_ACQUIRE);
+}
+
+uint32_t SessionCheckpoint::getCostUsPerSecond() const {
+    return countingMs ? (uint32_t)((uint64_t)getCostUs() * 1000ULL / countingMs) : 0;
+}
+
+void SessionCheckpoint::resetStats() {
+    rtcWrites = 0;
+    costUs = 0;
+    countingMs = 0;
+    __atomic_store_n(&journalStatsReset, true, __ATOMIC_RELEASE);
+}
+
+void SessionCheckpoint::makeRecord(const SessionSnapshot& session, Record& record) {
+    record.magic = MAGIC;
+    record.sequence = sequence++;
+    record.wallSeconds = wallAtBoot ? wallAtBoot + (millis() - bootMs) / 1000UL : 0;
+    record.session = session;
+    record.crc = crc32(&record, offsetof(Record, crc));
+}
+
+// ==================== RTC MEMORY ====================
+bool SessionCheckpoint::loadRtc(Record& record) {
+    if (hal.retained->size() < sizeof(Record)) return false;
+    memcpy(&record, hal.retained->data(), sizeof(Record));
+    return isValid(record);
+}
+
+void SessionCheckpoint::writeRtc(Record& record) {
+    if (hal.retained->size() < sizeof(Record)) return;
+    memcpy(hal.retained->data(), &record, sizeof(Record));
+    rtcWrites++;
+}
+
+// ==================== FLASH JOURNAL ====================
+bool SessionCheckpoint::scanJournal(Record& newest) {
+    bool found = false;
+    uint32_t newestSlot = 0;
+    for (uint32_t slot = 0; slot < slotCount; slot++) {
+        Record record;
+        if (!hal.journal->read(slot * sizeof(Record), &record, sizeof(record)) || !isValid(record)) continue;
+        if (!found || record.sequence > newest.sequence) {
+            newest = record;
+            newestSlot = slot;
+            found = true;
+        }
+    }
+    nextSlot = found ? (newestSlot + 1) % slotCount : 0;
+    return found;
+}
+
+void SessionCheckpoint::appendJournal(Record& record) {
+    if (slotCount == 0) return;
+
+    // Entering a sector: erase it (it holds the oldest records of the ring).
+    // Mid-sector, the slot must still be blank - a torn append leaves it dirty,
+    // in which case move on to the next sector.
+    bool erase = nextSlot % RECORDS_PER_SECTOR == 0;
+    if (!erase) {
+        uint32_t probe[sizeof(Record) / 4];
+        hal.journal->read(nextSlot * sizeof(Record), probe, sizeof(probe));
+        for (uint8_t i = 0; i < sizeof(Record) / 4 && !erase; i++) {
+            erase = probe[i] != 0xFFFFFFFF;
+        }
+        if (erase) {
+            nextSlot = ((nextSlot / RECORDS_PER_SECTOR + 1) * RECORDS_PER_SECTOR) % slotCount;
+        }
+    }
+    if (erase) {
+        hal.journal->eraseSector((nextSlot / RECORDS_PER_SECTOR) * FLASH_SECTOR_SIZE);
+        flashErases++;
+    }
+
+    hal.journal->write(nextSlot * sizeof(Record), &record, sizeof(Record));
+    flashWrites++;
+    TRACE(TRACE_JOURNAL_APPEND, record.session.state, record.sequence);
+    nextSlot = (nextSlot + 1) % slotCount;
+}
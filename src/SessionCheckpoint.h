@@ -0,0 +1,103 @@
+/**
+ * Session Checkpoint
+ * Lets an interrupted session survive a reset or power loss. Two tiers:
+ * - RTC memory: one record rewritten every second while counting (survives
+ *   warm resets such as a brownout or watchdog reset, costs a few microseconds)
+ * - Flash journal: records appended to a raw partition on every state change
+ *   and once a minute, oldest sector erased when the ring wraps (survives
+ *   power loss; a torn append fails its CRC and the previous record is used)
+ * Journal appends can erase a sector, so update() only queues them; service()
+ * writes them, from a low-priority task on the device.
+ * On boot the newest valid record of either tier wins. Time spent powered off
+ * is taken from the wall clock when there is one; without it (or with an RTC
+ * reading from before WALL_CLOCK_MIN_VALID at either end), a counting session
+ * comes back paused rather than with a guessed remaining time.
+ */
+
+#ifndef SESSION_CHECKPOINT_H
+#define SESSION_CHECKPOINT_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "types.h"
+#include "hal/Hal.h"
+#include "SnapshotChannel.h"
+
+class SessionCheckpoint {
+public:
+    // Constructor
+    SessionCheckpoint();
+
+    // Find the newest checkpoint (call once after the HAL is installed). Returns
+    // true if a session was in progress and is recent enough to resume; downtimeMs
+    // is how long the device was off.
+    bool begin(SessionSnapshot& session, uint32_t& downtimeMs);
+
+    // Checkpoint the session if its state changed or a write is due (call every loop);
+    // returns true if a journal append was queued for service()
+    bool update(const SessionSnapshot& session);
+
+    // Write the latest queued journal record, if any (may erase a sector); a newer
+    // checkpoint supersedes one still waiting. Call from one task only.
+    void service();
+    bool isJournalPending() const;
+
+    // Statistics (for performance monitoring)
+    uint32_t getRtcWrites() const { return rtcWrites; }
+    uint32_t getFlashWrites() const { return flashWrites; }
+    uint32_t getFlashErases() const { return flashErases; }
+    uint32_t getCostUs() const { return costUs + journalCostUs; } // Time spent writing checkpoints
+    uint32_t getCountingMs() const { return countingMs; }   // Time spent counting, to scale the cost
+    uint32_t getCostUsPerSecond() const;                    // Cost per second of counting
+    // Clears the update() side now; service() clears its own counters on its next call
+    void resetStats();
+
+private:
+    static const uint32_t MAGIC = 0x504B4350;   // "PCKP"
+
+    struct Record {
+        uint32_t magic;
+        uint32_t sequence;          // Increases with every checkpoint, across both tiers
+        uint32_t wallSeconds;       // Wall clock when written (0 = no wall clock)
+        SessionSnapshot session;
+        uint32_t crc;               // CRC-32 of everything above
+    };
+    static_assert(FLASH_SECTOR_SIZE % sizeof(Record) == 0, "journal records must tile a sector");
+    static const uint32_t RECORDS_PER_SECTOR = FLASH_SECTOR_SIZE / sizeof(Record);
+
+    SessionSnapshot last;           // Last checkpointed session
+    uint32_t sequence;              // Next sequence number
+    uint32_t nextSlot;              // Journal slot for the next append
+    uint32_t slotCount;             // Journal capacity (0 = no journal partition)
+    uint32_t wallAtBoot;
+    uint32_t bootMs;
+    uint32_t lastFlashElapsedMs;    // Session time of the last journal append
+    uint32_t lastUpdateMs;
+
+    // update() -> service() hand-off
+    SnapshotChannel<Record> journalRecords;
+    uint32_t journalQueued;         // Records queued by update()
+    uint32_t journalServiced;       // Queued records service() has dealt with
+    uint32_t journalSequence;       // Channel sequence of the last record written
+
+    // Statistics: update() side
+    uint32_t rtcWrites;
+    uint32_t costUs;
+    uint32_t countingMs;
+    // Statistics: service() side
+    uint32_t flashWrites;
+    uint32_t flashErases;
+    uint32_t journalCostUs;
+    bool journalStatsReset;         // Set by resetStats(), cleared by service()
+
+    bool loadRtc(Record& record);
+    bool scanJournal(Record& newest);
+    void writeRtc(Record& record);
+    void appendJournal(Record& record);
+    void makeRecord(const SessionSnapshot& session, Record& record);
+    static bool isValid(const Record& record);
+    static bool isCounting(uint8_t state);
+    static bool isWallValid(uint32_t seconds);
+};
+
+#endif // SESSION_CHECKPOINT_H
@@ -0,0 +1,381 @@
+/**
+ * Session History Implementation
+ */
+
+#include "SessionHistory.h"
+#include "Crc32.h"
+#include "Trace.h"
+
+// ==================== SECTOR READER ====================
+// Reads a sector through a small window so a scan never needs a 4 KB buffer
+class SessionHistory::SectorReader {
+public:
+    SectorReader(HalFlash& flash, uint32_t sector, uint32_t offset)
+        : flash(flash),
+          base(sector * FLASH_SECTOR_SIZE),
+          offset(offset),
+          windowStart(0),
+          windowLength(0) {
+    }
+
+    // Decode the record at the current position; false at the end of valid data
+    bool next(Record& record);
+    uint32_t getOffset() const { return offset; }
+
+private:
+    static const uint16_t WINDOW_SIZE = 128;
+
+    HalFlash& flash;
+    uint32_t base;
+    uint32_t offset;
+    uint32_t windowStart;
+    uint32_t windowLength;
+    uint8_t window[WINDOW_SIZE];
+
+    // Bytes available at the current position (refills the window when short)
+    uint32_t available();
+    static bool getVarint(const uint8_t* data, uint32_t length, uint32_t& pos, uint32_t& value);
+};
+
+uint32_t SessionHistory::SectorReader::available() {
+    uint32_t left = FLASH_SECTOR_SIZE - offset;
+    uint32_t want = left < MAX_RECORD_SIZE ? left : MAX_RECORD_SIZE;
+    if (offset < windowStart || offset + want > windowStart + windowLength) {
+        windowStart = offset;
+        windowLength = left < WINDOW_SIZE ? left : WINDOW_SIZE;
+        if (!flash.read(base + windowStart, window, windowLength)) windowLength = 0;
+    }
+    uint32_t inWindow = windowStart + windowLength - offset;
+    return inWindow < want ? inWindow : want;
+}
+
+bool SessionHistory::SectorReader::getVarint(const uint8_t* data, uint32_t length, uint32_t& pos,
+                                             uint32_t& value) {
+    value = 0;
+    for (uint8_t shift = 0; shift < 35 && pos < length; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool SessionHistory::SectorReader::next(Record& record) {
+    uint32_t length = available();
+    if (length == 0) return false;
+    const uint8_t* data = window + (offset - windowStart);
+    uint8_t head = data[0];
+    if (head == 0xFF) return false;     // Erased: end of the sector's records
+
+    uint32_t pos = 1;
+    record.kind = head >> 6;
+    record.marker = record.kind == KIND_MARKER;
+    if (record.marker) {
+        if ((head & 0x3E) != 0 || length < 6) return false;
+        record.wallClock = head & 1;
+        record.time = (uint32_t)data[1] | ((uint32_t)data[2] << 8) |
+                      ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+        pos = 5;
+    } else {
+        uint8_t minutes = head & 0x3F;
+        record.duration = minutes * 60UL;
+        if (minutes == 0 && !getVarint(data, length, pos, record.duration)) return false;
+        if (!getVarint(data, length, pos, record.time)) return false;
+    }
+    if (pos >= length || data[pos] != crc8(data, pos)) return false;  // Torn or corrupt
+    offset += pos + 1;
+    return true;
+}
+
+// ==================== LOG ====================
+SessionHistory::SessionHistory()
+    : posted(0),
+      serviced(0),
+      attempts(0),
+      lost(0),
+      sectorCount(0),
+      activeSector(-1),
+      writeOffset(0),
+      nextSequence(1),
+      lastTime(0),
+      lastWallClock(false),
+      haveTime(false),
+      appendCount(0),
+      bytesWritten(0),
+      sectorErases(0),
+      writeFailures(0) {
+}
+
+bool SessionHistory::begin() {
+    sectorCount = hal.history->size() / FLASH_SECTOR_SIZE;
+    if (sectorCount == 0) return false;
+
+    // The newest sector (highest sequence) holds the end of the log
+    SectorHeader newest;
+    int32_t newestSector = -1;
+    for (uint32_t i = 0; i < sectorCount; i++) {
+        SectorHeader header;
+        if (readHeader(*hal.history, i, header) &&
+            (newestSector < 0 || header.sequence > newest.sequence)) {
+            newest = header;
+            newestSector = i;
+        }
+    }
+    if (newestSector < 0) return true;  // Empty log: sector 0 is opened on the first append
+
+    uint32_t time;
+    bool wallClock;
+    uint32_t end;
+    uint32_t entries = scanSector(*hal.history, newestSector, newest, nullptr, nullptr, time, wallClock, end);
+
+    // Append after the last valid record, unless a torn append left garbage there
+    bool blank = true;
+    uint8_t chunk[64];
+    for (uint32_t pos = end; pos < FLASH_SECTOR_SIZE && blank; pos += sizeof(chunk)) {
+        uint32_t length = min<uint32_t>(sizeof(chunk), FLASH_SECTOR_SIZE - pos);
+        hal.history->read(newestSector * FLASH_SECTOR_SIZE + pos, chunk, length);
+        for (uint32_t i = 0; i < length && blank; i++) blank = chunk[i] == 0xFF;
+    }
+
+    activeSector = newestSector;
+    writeOffset = blank ? end : FLASH_SECTOR_SIZE;    // Full: the next append opens a new sector
+    nextSequence = newest.sequence + 1;
+    lastTime = time;
+    lastWallClock = wallClock;
+    haveTime = wallClock;   // Time since boot restarted: the first append needs a marker
+
+    Serial.print("History: sector ");
+    Serial.print(newestSector);
+    Serial.print(", ");
+    Serial.print(entries);
+    Serial.println(blank ? " sessions in it" : " sessions in it (torn tail skipped)");
+    return true;
+}
+
+bool SessionHistory::append(const HistoryEntry& entry) {
+    if (sectorCount == 0) return false;
+    uint8_t kindCode;
+    switch (entry.kind) {
+        case STATE_RUNNING:     kindCode = 0; break;
+        case STATE_SHORT_BREAK: kindCode = 1; break;
+        case STATE_LONG_BREAK:  kindCode = 2; break;
+        default:                return false;
+    }
+
+    uint32_t now = entry.endTime;
+    bool wallClock = entry.wallClock;
+    uint32_t duration = entry.duration;
+
+    // Deltas need a common time base; rebase with a marker when it jumps
+    uint8_t record[6 + MAX_RECORD_SIZE];
+    uint8_t length = 0;
+    uint32_t base = lastTime;
+    if (!haveTime || wallClock != lastWallClock || now < lastTime) {
+        length = encodeMarker(record, now, wallClock);
+        base = now;
+    }
+    length += encodeSession(record + length, kindCode, duration, now - base);
+
+    if (activeSector < 0 || writeOffset + length > FLASH_SECTOR_SIZE) {
+        // A fresh sector carries its own time base, so no marker is needed
+        uint32_t sector = activeSector < 0 ? 0 : (activeSector + 1) % sectorCount;
+        if (!openSector(sector, now, wallClock)) return false;
+        length = encodeSession(record, kindCode, duration, 0);
+    }
+
+    if (!hal.history->write(activeSector * FLASH_SECTOR_SIZE + writeOffset, record, length)) {
+        // Part of it may have landed: the next append starts a fresh sector
+        writeOffset = FLASH_SECTOR_SIZE;
+        return false;
+    }
+    writeOffset += length;
+    lastTime = now;
+    lastWallClock = wallClock;
+    haveTime = true;
+    appendCount++;
+    bytesWritten += length;
+    TRACE(TRACE_HISTORY_APPEND, entry.kind, length);
+    return true;
+}
+
+bool SessionHistory::post(const HistoryEntry& entry) {
+    if (!queue.push(entry)) return false;
+    __atomic_store_n(&posted, posted + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void SessionHistory::service() {
+    HistoryEntry entry;
+    while (queue.peek(entry)) {
+        if (!append(entry)) {
+            writeFailures++;
+            if (++attempts < HISTORY_APPEND_ATTEMPTS) return;   // Keep it queued for the next call
+            lost++;
+            Serial.println("History: flash write failed - session not logged");
+        }
+        attempts = 0;
+        queue.pop(entry);
+        __atomic_store_n(&serviced, serviced + 1, __ATOMIC_RELEASE);
+    }
+}
+
+bool SessionHistory::isPending() const {
+    return __atomic_load_n(&posted, __ATOMIC_ACQUIRE) != __atomic_load_n(&serviced, __ATOMIC_ACQUIRE);
+}
+
+bool SessionHistory::openSector(uint32_t sector, uint32_t baseTime, bool wallClock) {
+    // Carry the sector's erase count forward (the ring keeps them within one of each other)
+    SectorHeader header;
+    uint32_t erases = readHeader(*hal.history, sector, header) ? header.eraseCount + 1 : 1;
+    if (!hal.history->eraseSector(sector * FLASH_SECTOR_SIZE)) return false;
+    sectorErases++;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.sequence = nextSequence++;
+    header.eraseCount = erases;
+    header.baseTime = baseTime;
+    header.wallClock = wallClock;
+    header.crc = crc32(&header, offsetof(SectorHeader, crc));
+    if (!hal.history->write(sector * FLASH_SECTOR_SIZE, &header, sizeof(header))) return false;
+    bytesWritten += sizeof(header);
+
+    activeSector = sector;
+    writeOffset = sizeof(header);
+    lastTime = baseTime;
+    lastWallClock = wallClock;
+    haveTime = true;
+    return true;
+}
+
+HistoryEntry SessionHistory::stamp(TimerState kind, uint32_t duration) {
+    // Once per session, so the RTC read is affordable
+    HistoryEntry entry;
+    entry.endTime = hal.clock->wallSeconds();
+    entry.wallClock = entry.endTime != 0;
+    if (!entry.wallClock) entry.endTime = millis() / 1000UL;
+    entry.duration = duration;
+    entry.kind = kind;
+    return entry;
+}
+
+// ==================== READING ====================
+bool SessionHistory::readHeader(HalFlash& flash, uint32_t sector, SectorHeader& header) {
+    return flash.read(sector * FLASH_SECTOR_SIZE, &header, sizeof(header)) &&
+           header.magic == MAGIC &&
+           header.crc == crc32(&header, offsetof(SectorHeader, crc));
+}
+
+uint32_t SessionHistory::scanSector(HalFlash& flash, uint32_t sector, const SectorHeader& header,
+                                    Visitor visit, void* context, uint32_t& time, bool& wallClock,
+                                    uint32_t& end) {
+    time = header.baseTime;
+    wallClock = header.wallClock;
+    uint32_t count = 0;
+    SectorReader reader(flash, sector, sizeof(SectorHeader));
+    Record record;
+    while (reader.next(record)) {
+        if (record.marker) {
+            time = record.time;
+            wallClock = record.wallClock;
+            continue;
+        }
+        time += record.time;
+        count++;
+        if (visit) {
+            HistoryEntry entry;
+            entry.endTime = time;
+            entry.duration = record.duration;
+            entry.kind = record.kind == 0 ? STATE_RUNNING :
+                         record.kind == 1 ? STATE_SHORT_BREAK : STATE_LONG_BREAK;
+            entry.wallClock = wallClock;
+            visit(entry, context);
+        }
+    }
+    end = reader.getOffset();
+    return count;
+}
+
+uint32_t SessionHistory::read(HalFlash& flash, Visitor visit, void* context) {
+    uint32_t sectors = flash.size() / FLASH_SECTOR_SIZE;
+    int32_t newestSector = -1;
+    uint32_t newestSequence = 0;
+    for (uint32_t i = 0; i < sectors; i++) {
+        SectorHeader header;
+        if (readHeader(flash, i, header) && (newestSector < 0 || header.sequence > newestSequence)) {
+            newestSequence = header.sequence;
+            newestSector = i;
+        }
+    }
+    if (newestSector < 0) return 0;
+
+    // Sectors are filled in ring order, so the oldest follows the newest
+    uint32_t count = 0;
+    for (uint32_t i = 1; i <= sectors; i++) {
+        uint32_t sector = (newestSector + i) % sectors;
+        SectorHeader header;
+        if (!readHeader(flash, sector, header)) continue;
+        uint32_t time;
+        bool wallClock;
+        uint32_t end;
+        count += scanSector(flash, sector, header, visit, context, time, wallClock, end);
+    }
+    return count;
+}
+
+void SessionHistory::readWear(HalFlash& flash, uint32_t& minErases, uint32_t& maxErases) {
+    uint32_t sectors = flash.size() / FLASH_SECTOR_SIZE;
+    minErases = UINT32_MAX;
+    maxErases = 0;
+    for (uint32_t i = 0; i < sectors; i++) {
+        SectorHeader header;
+        uint32_t erases = readHeader(flash, i, header) ? header.eraseCount : 0;
+        minErases = min(minErases, erases);
+        maxErases = max(maxErases, erases);
+    }
+    if (sectors == 0) minErases = 0;
+}
+
+// ==================== ENCODING ====================
+uint8_t SessionHistory::putVarint(uint8_t* out, uint32_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+uint8_t SessionHistory::encodeSession(uint8_t* out, uint8_t kind, uint32_t duration, uint32_t delta) {
+    // Whole minutes (the usual case) fit in the head byte
+    uint8_t minutes = (duration % 60 == 0 && duration / 60 >= 1 && duration / 60 <= 63) ? duration / 60 : 0;
+    uint8_t length = 0;
+    out[length++] = (uint8_t)(kind << 6) | minutes;
+    if (minutes == 0) length += putVarint(out + length, duration);
+    length += putVarint(out + length, delta);
+    out[length] = crc8(out, length);
+    return length + 1;
+}
+
+uint8_t SessionHistory::encodeMarker(uint8_t* out, uint32_t time, bool wallClock) {
+    out[0] = (uint8_t)(KIND_MARKER << 6) | (wallClock ? 1 : 0);
+    out[1] = (uint8_t)time;
+    out[2] = (uint8_t)(time >> 8);
+    out[3] = (uint8_t)(time >> 16);
+    out[4] = (uint8_t)(time >> 24);
+    out[5] = crc8(out, 5);
+    return 6;
+}
+
+uint8_t SessionHistory::crc8(const uint8_t* data, size_t length) {
+    // CRC-8, polynomial 0x07
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
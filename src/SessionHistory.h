@@ -0,0 +1,136 @@
+/**
+ * Session History
+ * Append-only log of every completed session in a raw flash partition.
+ *
+ * The partition is a ring of 4 KB sectors, filled in order and erased one at
+ * a time when the ring wraps, so every sector sees the same number of erases.
+ * Each sector starts with a header (sequence, erase count, time base) and is
+ * self-contained: records store their end time as a delta from the previous
+ * record, or from the header for the first one.
+ *
+ * Record (typically 4 bytes):
+ *   kind:2 | minutes:6   kind 0-2 = work / short break / long break; minutes is
+ *                        the duration if it is a whole 1-63, else 0 and a
+ *                        varint of seconds follows
+ *   varint               seconds since the previous record ended
+ *   crc8                 over the bytes above (a torn append fails it)
+ * Time marker (6 bytes), written when the time base jumps (reboot without a
+ * wall clock, clock set backwards):
+ *   0xC0 | wallClock     then the absolute time (4 bytes, little-endian), crc8
+ */
+
+#ifndef SESSION_HISTORY_H
+#define SESSION_HISTORY_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "types.h"
+#include "hal/Hal.h"
+#include "SpscQueue.h"
+
+// One completed session as read back from the log
+struct HistoryEntry {
+    uint32_t endTime;       // Seconds: wall clock (Unix time) or, without one, since boot
+    uint32_t duration;      // Configured session length in seconds
+    TimerState kind;        // STATE_RUNNING (work), STATE_SHORT_BREAK or STATE_LONG_BREAK
+    bool wallClock;         // endTime is wall clock time
+};
+
+class SessionHistory {
+public:
+    // Constructor
+    SessionHistory();
+
+    // Find the end of the log (call once after the HAL is installed); false if
+    // there is no history partition
+    bool begin();
+
+    // Entry for a session ending now (reads the wall clock once)
+    static HistoryEntry stamp(TimerState kind, uint32_t duration);
+
+    // Log a finished session
+    bool append(const HistoryEntry& entry);
+    bool append(TimerState kind, uint32_t duration) { return append(stamp(kind, duration)); }
+
+    // Queue a finished session for service() to append, so the caller never waits
+    // out a sector erase; false if the queue is full
+    bool post(const HistoryEntry& entry);
+    // Append everything queued (call from one task only); an entry whose append
+    // fails stays queued for the next call, up to HISTORY_APPEND_ATTEMPTS tries
+    void service();
+    bool isPending() const;
+
+    // Visit every entry in a log partition, oldest first; returns the entry count
+    typedef void (*Visitor)(const HistoryEntry& entry, void* context);
+    static uint32_t read(HalFlash& flash, Visitor visit, void* context);
+    uint32_t read(Visitor visit, void* context) const { return read(*hal.history, visit, context); }
+
+    // Erase counts across the partition's sectors (wear leveling check)
+    static void readWear(HalFlash& flash, uint32_t& minErases, uint32_t& maxErases);
+
+    // Statistics (for performance monitoring)
+    uint32_t getAppendCount() const { return appendCount; }
+    uint32_t getBytesWritten() const { return bytesWritten; }
+    uint32_t getSectorErases() const { return sectorErases; }
+    uint32_t getWriteFailures() const { return writeFailures; }  // Failed append attempts
+    uint32_t getDropped() const { return queue.getDropped() + lost; }   // Sessions lost to a full queue or failing flash
+
+private:
+    static const uint32_t MAGIC = 0x53494850;   // "PHIS"
+    static const uint8_t MAX_RECORD_SIZE = 12;
+    static const uint8_t KIND_MARKER = 3;
+
+    struct SectorHeader {
+        uint32_t magic;
+        uint32_t sequence;      // Increases with every sector opened
+        uint32_t eraseCount;    // Times this sector has been erased
+        uint32_t baseTime;      // Time the first record's delta counts from
+        uint8_t wallClock;      // baseTime is wall clock time
+        uint8_t reserved[3];
+        uint32_t crc;           // CRC-32 of everything above
+    };
+
+    // Buffered sequential reads within one sector
+    class SectorReader;
+
+    // Decoded record: a session, or a time marker that rebases the deltas
+    struct Record {
+        bool marker;
+        uint8_t kind;
+        uint32_t duration;
+        uint32_t time;          // Delta for sessions, absolute for markers
+        bool wallClock;
+    };
+
+    // post() -> service() hand-off
+    SpscQueue<HistoryEntry, 8> queue;
+    uint32_t posted;            // Entries queued by post()
+    uint32_t serviced;          // Entries service() has appended (or given up on)
+    uint8_t attempts;           // Failed appends of the entry at the head of the queue
+    uint32_t lost;              // Entries given up on after HISTORY_APPEND_ATTEMPTS
+
+    uint32_t sectorCount;
+    int32_t activeSector;       // Sector being appended to (-1 = open one on the next append)
+    uint32_t writeOffset;       // Next free byte in the active sector
+    uint32_t nextSequence;
+    uint32_t lastTime;          // End time of the last record (delta base)
+    bool lastWallClock;
+    bool haveTime;
+
+    uint32_t appendCount;
+    uint32_t bytesWritten;
+    uint32_t sectorErases;
+    uint32_t writeFailures;
+
+    bool openSector(uint32_t sector, uint32_t baseTime, bool wallClock);
+    static bool readHeader(HalFlash& flash, uint32_t sector, SectorHeader& header);
+    static uint32_t scanSector(HalFlash& flash, uint32_t sector, const SectorHeader& header,
+                               Visitor visit, void* context, uint32_t& time, bool& wallClock,
+                               uint32_t& end);
+    static uint8_t encodeSession(uint8_t* out, uint8_t kind, uint32_t duration, uint32_t delta);
+    static uint8_t encodeMarker(uint8_t* out, uint32_t time, bool wallClock);
+    static uint8_t putVarint(uint8_t* out, uint32_t value);
+    static uint8_t crc8(const uint8_t* data, size_t length);
+};
+
+#endif // SESSION_HISTORY_H
@@ -0,0 +1,151 @@
+/**
+ * Settings Store Implementation
+ */
+
+#include "SettingsStore.h"
+#include "Crc32.h"
+#include "Theme.h"
+
+static const char* const SETTINGS_KEY = "settings";
+
+// NVS wear model: a blob write takes ~3 entries of 32 bytes (blob index + header +
+// data); the default 20 KB nvs partition holds 4 usable pages of 126 entries, and
+// a page is erased once every entry in it has been consumed
+static const uint32_t NVS_ENTRIES_PER_WRITE = 3;
+static const uint32_t NVS_ENTRIES_PER_ERASE_CYCLE = 4 * 126;
+
+SettingsStore::SettingsStore()
+    : dirty(false),
+      lastChangeTime(0) {
+    memset(&record, 0, sizeof(record));
+    memset(&pending, 0, sizeof(pending));
+}
+
+bool SettingsStore::isValid(const PomodoroSettings& settings) {
+    // Same ranges InputHandler allows when editing
+    return settings.workDuration >= 60 && settings.workDuration <= 3600 &&
+           settings.shortBreakDuration >= 60 && settings.shortBreakDuration <= 3600 &&
+           settings.longBreakDuration >= 60 && settings.longBreakDuration <= 3600 &&
+           settings.pomodorosUntilLongBreak >= 1 && settings.pomodorosUntilLongBreak <= 10 &&
+           settings.brightnessLevel >= 1 && settings.brightnessLevel <= 6 &&
+           settings.themeIndex < THEME_COUNT;
+}
+
+bool SettingsStore::isSame(const PomodoroSettings& a, const PomodoroSettings& b) {
+    return a.workDuration == b.workDuration &&
+           a.shortBreakDuration == b.shortBreakDuration &&
+           a.longBreakDuration == b.longBreakDuration &&
+           a.pomodorosUntilLongBreak == b.pomodorosUntilLongBreak &&
+           a.brightnessLevel == b.brightnessLevel &&
+           a.themeIndex == b.themeIndex;
+}
+
+uint32_t SettingsStore::checksum(const Record& record) {
+    // Chained over the fields so padding (after settings, before writeCount) never counts
+    const PomodoroSettings& s = record.settings;
+    uint32_t crc = crc32(&record.version, sizeof(record.version));
+    crc = crc32(&record.size, sizeof(record.size), crc);
+    crc = crc32(&s.workDuration, sizeof(s.workDuration), crc);
+    crc = crc32(&s.shortBreakDuration, sizeof(s.shortBreakDuration), crc);
+    crc = crc32(&s.longBreakDuration, sizeof(s.longBreakDuration), crc);
+    crc = crc32(&s.pomodorosUntilLongBreak, sizeof(s.pomodorosUntilLongBreak), crc);
+    crc = crc32(&s.brightnessLevel, sizeof(s.brightnessLevel), crc);
+    crc = crc32(&s.themeIndex, sizeof(s.themeIndex), crc);
+    return crc32(&record.writeCount, sizeof(record.writeCount), crc);
+}
+
+bool SettingsStore::loadV1(Record& record) {
+    RecordV1 stored;
+    if (!hal.storage->load(SETTINGS_KEY, &stored, sizeof(stored)) ||
+        stored.version != 1 || stored.size != sizeof(RecordV1) ||
+        stored.crc != crc32(&stored, offsetof(RecordV1, crc))) {
+        return false;
+    }
+
+    // Same fields plus the default theme; written in the new layout with the next change
+    memset(&record, 0, sizeof(record));
+    record.version = SCHEMA_VERSION;
+    record.size = sizeof(Record);
+    record.settings.workDuration = stored.workDuration;
+    record.settings.shortBreakDuration = stored.shortBreakDuration;
+    record.settings.longBreakDuration = stored.longBreakDuration;
+    record.settings.pomodorosUntilLongBreak = stored.pomodorosUntilLongBreak;
+    record.settings.brightnessLevel = stored.brightnessLevel;
+    record.settings.themeIndex = 0;
+    record.writeCount = stored.writeCount;
+    record.crc = checksum(record);
+    return true;
+}
+
+bool SettingsStore::load(PomodoroSettings& settings) {
+    Record stored;
+    bool current = hal.storage->load(SETTINGS_KEY, &stored, sizeof(stored)) &&
+                   stored.version == SCHEMA_VERSION &&
+                   stored.size == sizeof(Record) &&
+                   stored.crc == checksum(stored);
+    bool migrated = !current && loadV1(stored);
+    bool ok = (current || migrated) && isValid(stored.settings);
+
+    if (ok) {
+        record = stored;
+        settings = stored.settings;
+        Serial.print(migrated ? "Settings loaded from version 1 (" : "Settings loaded (");
+        Serial.print(record.writeCount);
+        Serial.println(" writes so far)");
+    } else {
+        // Start from the defaults; keep counting wear from zero
+        record.settings = settings;
+        Serial.println("Settings: no valid record - using defaults");
+    }
+    pending = settings;
+    dirty = false;
+    return ok;
+}
+
+void SettingsStore::update(const PomodoroSettings& settings) {
+    if (isSame(settings, pending)) return;
+    pending = settings;
+    lastChangeTime = millis();
+    // Dialing back to the stored values cancels the write
+    dirty = !isSame(pending, record.settings);
+}
+
+void SettingsStore::service() {
+    if (dirty && millis() - lastChangeTime >= SETTINGS_COMMIT_DELAY_MS) {
+        commit();
+    }
+}
+
+void SettingsStore::flush() {
+    if (dirty) commit();
+}
+
+uint32_t SettingsStore::getMsUntilCommit() const {
+    if (!dirty) return UINT32_MAX;
+    uint32_t quiet = millis() - lastChangeTime;
+    return quiet >= SETTINGS_COMMIT_DELAY_MS ? 0 : SETTINGS_COMMIT_DELAY_MS - quiet;
+}
+
+uint32_t SettingsStore::getEstimatedEraseCycles() const {
+    return (record.writeCount * NVS_ENTRIES_PER_WRITE) / NVS_ENTRIES_PER_ERASE_CYCLE;
+}
+
+void SettingsStore::commit() {
+    // Start from zeros rather than stack contents (padding is left out of the CRC either way)
+    Record next;
+    memset(&next, 0, sizeof(next));
+    next.version = SCHEMA_VERSION;
+    next.size = sizeof(Record);
+    next.settings = pending;
+    next.writeCount = record.writeCount + 1;
+    next.crc = checksum(next);
+
+    if (hal.storage->save(SETTINGS_KEY, &next, sizeof(next))) {
+        record = next;
+        dirty = false;
+    } else {
+        // Try again after another quiet period rather than on every loop
+        lastChangeTime = millis();
+        Serial.println("Settings: write failed");
+    }
+}
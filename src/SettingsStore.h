@@ -0,0 +1,84 @@
+/**
+ * Settings Store
+ * Keeps PomodoroSettings in persistent storage (NVS on the device) as a
+ * versioned, CRC-checked record. Changes are coalesced: the record is only
+ * written once the settings have been left alone for SETTINGS_COMMIT_DELAY_MS,
+ * so spinning the dial costs one flash write, not one per detent.
+ */
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "types.h"
+#include "hal/Hal.h"
+
+class SettingsStore {
+public:
+    // Bump when PomodoroSettings changes layout; load() migrates older records it
+    // knows (version 1: no themeIndex) and ignores anything else
+    static const uint16_t SCHEMA_VERSION = 2;
+
+    // Constructor
+    SettingsStore();
+
+    // Replace settings with the stored copy; false (settings untouched) if there is
+    // no valid record
+    bool load(PomodoroSettings& settings);
+
+    // Note the current settings; a change starts (or restarts) the commit delay
+    void update(const PomodoroSettings& settings);
+
+    // Write a pending change once the settings have been quiet long enough
+    void service();
+
+    // Write a pending change now (e.g. before a reboot)
+    void flush();
+
+    // Milliseconds until service() has a write due (UINT32_MAX = nothing pending)
+    uint32_t getMsUntilCommit() const;
+
+    // Wear statistics: record writes over the device's life, and what that
+    // means for the NVS flash sectors
+    uint32_t getWriteCount() const { return record.writeCount; }
+    uint32_t getEstimatedEraseCycles() const;
+    bool isDirty() const { return dirty; }
+
+private:
+    struct Record {
+        uint16_t version;
+        uint16_t size;              // sizeof(Record), catches layout changes without a version bump
+        PomodoroSettings settings;
+        uint32_t writeCount;
+        uint32_t crc;               // CRC-32 of the fields above (see checksum())
+    };
+
+    // Version 1 layout (before themeIndex); no padding, so its CRC is over the raw bytes
+    struct RecordV1 {
+        uint16_t version;
+        uint16_t size;
+        uint16_t workDuration;
+        uint16_t shortBreakDuration;
+        uint16_t longBreakDuration;
+        uint8_t pomodorosUntilLongBreak;
+        uint8_t brightnessLevel;
+        uint32_t writeCount;
+        uint32_t crc;
+    };
+    static_assert(sizeof(RecordV1) == 20, "version 1 records are 20 bytes");
+
+    Record record;                  // Last committed (or loaded) contents
+    PomodoroSettings pending;
+    bool dirty;
+    uint32_t lastChangeTime;
+
+    void commit();
+    static bool loadV1(Record& record);
+    static bool isValid(const PomodoroSettings& settings);
+    // Field by field: the structs have padding bytes holding whatever was there before
+    static bool isSame(const PomodoroSettings& a, const PomodoroSettings& b);
+    static uint32_t checksum(const Record& record);
+};
+
+#endif // SETTINGS_STORE_H
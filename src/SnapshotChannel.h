@@ -0,0 +1,42 @@
+/**
+ * Snapshot Channel
+ * Lock-free single-writer publication of a small struct (sequence lock):
+ * the writer never blocks, readers retry if they raced a publish
+ */
+
+#ifndef SNAPSHOT_CHANNEL_H
+#define SNAPSHOT_CHANNEL_H
+
+#include <stdint.h>
+
+template <typename T>
+class SnapshotChannel {
+public:
+    SnapshotChannel() : sequence(0), value() {}
+
+    // Writer side (one task only)
+    void publish(const T& next) {
+        uint32_t s = sequence;
+        __atomic_store_n(&sequence, s + 1, __ATOMIC_RELAXED); // Odd: write in progress
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        value = next;
+        __atomic_store_n(&sequence, s + 2, __ATOMIC_RELEASE);
+    }
+
+    // Reader side (any task); returns the sequence number of the copy
+    uint32_t read(T& out) const {
+        for (;;) {
+            uint32_t before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+            if (before & 1) continue;   // Publish in progress on the other core
+            out = value;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) == before) return before;
+        }
+    }
+
+private:
+    uint32_t sequence;
+    T value;
+};
+
+#endif // SNAPSHOT_CHANNEL_H
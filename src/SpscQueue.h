@@ -0,0 +1,61 @@
+/**
+ * SPSC Queue
+ * Lock-free single-producer / single-consumer ring (e.g. ISR -> loop task).
+ * Indices run free and wrap at 256, so SIZE must be a power of two up to 128.
+ * A full queue keeps the older items and counts the newer ones as dropped.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+
+template <typename T, uint8_t SIZE>
+class SpscQueue {
+    static_assert(SIZE > 0 && SIZE <= 128 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two up to 128");
+
+public:
+    SpscQueue() : head(0), tail(0), dropped(0) {}
+
+    // Producer side (one ISR or task); inlined so it runs from the caller's IRAM
+    __attribute__((always_inline)) inline bool push(const T& item) {
+        uint8_t h = head;
+        if ((uint8_t)(h - tail) >= SIZE) {
+            dropped++;          // Consumer is too far behind - keep the older items
+            return false;
+        }
+        items[h % SIZE] = item;
+        __sync_synchronize();
+        head = h + 1;           // Publish after the slot is written
+        return true;
+    }
+
+    // Consumer side (one task); false if the queue is empty
+    bool peek(T& item) const {
+        uint8_t t = tail;
+        if (t == head) return false;
+        __sync_synchronize();
+        item = items[t % SIZE];     // The producer never writes a slot before it is popped
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint8_t t = tail;
+        if (t == head) return false;
+        item = items[t % SIZE];
+        __sync_synchronize();
+        tail = t + 1;           // Publish the free slot only after the copy
+        return true;
+    }
+
+    uint8_t size() const { return (uint8_t)(head - tail); }
+    uint32_t getDropped() const { return dropped; }
+
+private:
+    T items[SIZE];
+    volatile uint8_t head;      // Written only by the producer
+    volatile uint8_t tail;      // Written only by the consumer
+    volatile uint32_t dropped;
+};
+
+#endif // SPSC_QUEUE_H
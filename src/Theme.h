@@ -0,0 +1,199 @@
+/**
+ * Theme and Layout Tables
+ * Every screen region, text size and color the display uses, resolved at
+ * compile time from config.h. Geometry is one table for all themes; colors
+ * and labels are tables indexed by TimerState, so draw code looks them up
+ * instead of branching on the state. Themes are switched at runtime by
+ * pointing the display at another entry of THEMES.
+ */
+
+#ifndef THEME_H
+#define THEME_H
+
+#include <M5GFX.h>
+#include "config.h"
+#include "types.h"
+
+// ==================== LAYOUT ====================
+struct UiRect {
+    int16_t x, y, w, h;
+};
+
+// Text anchor: position, datum (top_center, middle_center, ...) and text size
+struct UiText {
+    int16_t x, y;
+    uint8_t datum;
+    uint8_t size;
+};
+
+// A region is cleared to its background, then its text (or icon) drawn at the anchor
+struct UiRegion {
+    UiRect box;
+    UiText text;
+};
+
+// Rows of a menu-like list; row i is the first row moved down by i * pitch
+struct UiList {
+    UiRegion firstRow;
+    int16_t pitch;
+};
+
+struct ScreenLayout {
+    // Timer screens
+    UiRegion counter;       // "Pomodoros: N" across the top
+    UiRegion tomato;        // Icon box; anchor is its center
+    UiRegion time;          // MM:SS box; the digits are cells of box height
+    UiRegion status;        // "Focusing" etc. under the countdown
+    UiRegion instruction;   // Button hints above the gear
+    UiRegion gear;          // Icon clear box; anchor is the icon center
+    // List screens (settings, statistics)
+    UiRegion title;
+    UiList settings;
+    UiList stats;
+    UiRegion settingsFooter;    // Anchor is the first of two lines
+    int16_t footerPitch;
+    UiRegion statsFooter;
+};
+
+const uint8_t SETTINGS_MENU_ROWS = 7;   // Work, Short, Long, Pomodoros/Long, Brightness, Theme, Back
+const uint8_t STATS_ROWS = 6;
+const int16_t TOMATO_SIZE = 32;
+const int16_t GEAR_SIZE = 24;
+
+inline constexpr ScreenLayout LAYOUT = {
+    // counter: stops above the ring
+    { { 0, 0, SCREEN_WIDTH, 25 }, { CENTER_X, 20, middle_center, 1 } },
+    // tomato: between the counter and the countdown
+    { { CENTER_X - TOMATO_SIZE / 2, 60 - TOMATO_SIZE / 2, TOMATO_SIZE, TOMATO_SIZE },
+      { CENTER_X, 60, middle_center, 0 } },
+    // time: centered in the ring
+    { { CENTER_X - 80, CENTER_Y - 25, 160, 45 }, { CENTER_X, CENTER_Y, middle_center, 5 } },
+    // status
+    { { CENTER_X - 60, CENTER_Y + 30, 120, 20 }, { CENTER_X, CENTER_Y + 40, middle_center, 2 } },
+    // instruction: high enough to clear the gear
+    { { 0, SCREEN_HEIGHT - 58, SCREEN_WIDTH, 20 }, { CENTER_X, SCREEN_HEIGHT - 48, middle_center, 1 } },
+    // gear: bottom center (the fallback glyph is text size 2)
+    { { CENTER_X - 15, SCREEN_HEIGHT - 35, 30, 30 }, { CENTER_X, SCREEN_HEIGHT - 20, middle_center, 2 } },
+    // title
+    { { 0, 8, SCREEN_WIDTH, 20 }, { CENTER_X, 10, top_center, 2 } },
+    // settings rows
+    { { { 10, 48, SCREEN_WIDTH - 20, 18 }, { CENTER_X, 50, top_center, 1 } }, 21 },
+    // stats rows
+    { { { 10, 48, SCREEN_WIDTH - 20, 18 }, { CENTER_X, 50, top_center, 1 } }, 25 },
+    // footers
+    { { 0, SCREEN_HEIGHT - 45, SCREEN_WIDTH, 45 }, { CENTER_X, SCREEN_HEIGHT - 35, top_center, 1 } },
+    15,
+    { { 0, SCREEN_HEIGHT - 45, SCREEN_WIDTH, 45 }, { CENTER_X, SCREEN_HEIGHT - 30, top_center, 1 } }
+};
+
+// Row i of a list
+constexpr UiRect listRowBox(const UiList& list, uint8_t i) {
+    return { list.firstRow.box.x, (int16_t)(list.firstRow.box.y + i * list.pitch),
+             list.firstRow.box.w, list.firstRow.box.h };
+}
+constexpr int16_t listRowTextY(const UiList& list, uint8_t i) {
+    return list.firstRow.text.y + i * list.pitch;
+}
+constexpr int16_t rectBottom(const UiRect& r) { return r.y + r.h; }
+
+static_assert(rectBottom(LAYOUT.counter.box) <= CENTER_Y - (CIRCLE_RADIUS + CIRCLE_THICKNESS / 2),
+              "counter overlaps the progress ring");
+static_assert(rectBottom(LAYOUT.title.box) <= LAYOUT.settings.firstRow.box.y &&
+              rectBottom(LAYOUT.title.box) <= LAYOUT.stats.firstRow.box.y, "title overlaps the first row");
+static_assert(rectBottom(listRowBox(LAYOUT.settings, SETTINGS_MENU_ROWS - 1)) <= LAYOUT.settingsFooter.box.y,
+              "settings rows run into the footer");
+static_assert(rectBottom(listRowBox(LAYOUT.stats, STATS_ROWS - 1)) <= LAYOUT.statsFooter.box.y,
+              "statistics rows run into the footer");
+static_assert(rectBottom(LAYOUT.instruction.box) <= LAYOUT.gear.box.y, "instructions overlap the gear");
+
+// ==================== LABELS ====================
+struct StateLabels {
+    const char* status;
+    const char* instruction;
+};
+
+inline constexpr StateLabels STATE_LABELS[STATE_COUNT] = {
+    { "Ready",       "Press: Start | Hold: Reset" },   // STATE_IDLE
+    { "Focusing",    "Press: Pause | Hold: Reset" },   // STATE_RUNNING
+    { "Paused",      "Press: Resume | Hold: Reset" },  // STATE_PAUSED
+    { "Short Break", "Press: Pause | Hold: Reset" },   // STATE_SHORT_BREAK
+    { "Long Break",  "Press: Pause | Hold: Reset" },   // STATE_LONG_BREAK
+    { "",            "" },                             // STATE_SETTINGS
+    { "",            "" },                             // STATE_STATS
+};
+
+// ==================== THEMES ====================
+struct StateStyle {
+    uint16_t background;
+    uint16_t arc;               // Elapsed part of the progress arc
+};
+
+struct Theme {
+    const char* name;
+    uint16_t text;
+    uint16_t track;             // Remaining part of the progress arc
+    uint16_t listBackground;    // Settings and statistics screens
+    uint16_t highlightText;     // Selected settings row
+    uint16_t highlightBackground;
+    StateStyle states[STATE_COUNT];
+};
+
+inline constexpr Theme THEMES[] = {
+    // Classic: full-screen state colors (paused goes dark)
+    { "Classic", COLOR_TEXT, COLOR_PROGRESS_BG, COLOR_BG, COLOR_WORK, COLOR_PROGRESS_BG, {
+        { COLOR_WORK_BG,        COLOR_PROGRESS },   // STATE_IDLE
+        { COLOR_WORK_BG,        COLOR_PROGRESS },   // STATE_RUNNING
+        { COLOR_BG,             COLOR_PROGRESS },   // STATE_PAUSED
+        { COLOR_SHORT_BREAK_BG, COLOR_PROGRESS },   // STATE_SHORT_BREAK
+        { COLOR_LONG_BREAK_BG,  COLOR_PROGRESS },   // STATE_LONG_BREAK
+        { COLOR_BG,             COLOR_PROGRESS },   // STATE_SETTINGS
+        { COLOR_BG,             COLOR_PROGRESS },   // STATE_STATS
+    } },
+    // Midnight: black everywhere, the state color moves to the arc (less light at night)
+    { "Midnight", COLOR_TEXT, COLOR_PROGRESS_BG, COLOR_BG, COLOR_WORK, COLOR_PROGRESS_BG, {
+        { COLOR_BG, COLOR_WORK },                   // STATE_IDLE
+        { COLOR_BG, COLOR_WORK },                   // STATE_RUNNING
+        { COLOR_BG, COLOR_PROGRESS },               // STATE_PAUSED
+        { COLOR_BG, COLOR_BREAK },                  // STATE_SHORT_BREAK
+        { COLOR_BG, COLOR_LONG_BREAK },             // STATE_LONG_BREAK
+        { COLOR_BG, COLOR_PROGRESS },               // STATE_SETTINGS
+        { COLOR_BG, COLOR_PROGRESS },               // STATE_STATS
+    } },
+};
+const uint8_t THEME_COUNT = sizeof(THEMES) / sizeof(THEMES[0]);
+
+// Every background any theme paints, without duplicates (icons are pre-blended per background)
+const uint8_t MAX_THEME_BACKGROUNDS = 6;
+
+struct ColorSet {
+    uint16_t colors[MAX_THEME_BACKGROUNDS];
+    uint8_t count;
+    bool overflow;
+};
+
+constexpr void addColor(ColorSet& set, uint16_t color) {
+    for (uint8_t i = 0; i < set.count; i++) {
+        if (set.colors[i] == color) return;
+    }
+    if (set.count == MAX_THEME_BACKGROUNDS) {
+        set.overflow = true;
+        return;
+    }
+    set.colors[set.count++] = color;
+}
+
+constexpr ColorSet collectBackgrounds() {
+    ColorSet set = {};
+    for (uint8_t t = 0; t < THEME_COUNT; t++) {
+        for (uint8_t s = 0; s < STATE_COUNT; s++) {
+            addColor(set, THEMES[t].states[s].background);
+        }
+        addColor(set, THEMES[t].listBackground);
+    }
+    return set;
+}
+
+inline constexpr ColorSet THEME_BACKGROUNDS = collectBackgrounds();
+static_assert(!THEME_BACKGROUNDS.overflow, "themes use more than MAX_THEME_BACKGROUNDS backgrounds");
+
+#endif // THEME_H
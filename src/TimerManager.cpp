@@ -1,21 +1,45 @@
 /**
  * Timer Manager Implementation
- * All timer logic moved here from main.cpp
- * EXACT same behavior - nothing changed!
+ * Session timing on the monotonic microsecond clock, the non-blocking
+ * alarm sequence and the session cycle
  */
 
 #include "TimerManager.h"
+#include "Trace.h"
+
+// Monotonic 64-bit microsecond clock (does not wrap like millis())
+static inline uint64_t nowUs() {
+    return hal.clock->micros();
+}
+
+// Completion alarm: four short beeps then one long beep (frequency 0 = silence).
+// The leading pause gives the speaker time to settle after end().
+const TimerManager::BeepStep TimerManager::BEEP_PATTERN[] = {
+    {    0,  50 },
+    { 3000, 250 }, { 0, 300 },
+    { 3000, 250 }, { 0, 300 },
+    { 3000, 250 }, { 0, 300 },
+    { 3000, 250 }, { 0, 300 },
+    { 3000, 400 }
+};
+const uint8_t TimerManager::BEEP_STEP_COUNT = sizeof(BEEP_PATTERN) / sizeof(BEEP_PATTERN[0]);
 
 TimerManager::TimerManager()
-    : timerStartTime(0),
+    : segmentStartUs(0),
+      elapsedBeforeSegmentUs(0),
+      segmentRunning(false),
+      timerActive(false),
       timerRemaining(0),
       timerDuration(0),
       lastPomodoroDuration(0),
+      pomodorosSinceLongBreak(0),
       stateBeforePause(STATE_IDLE),
       timerCompleted(false),
+      alarmActive(false),
       timerCompletionTime(0),
       beepState(0),
-      lastBeepTime(0) {
+      lastBeepTime(0),
+      sessionCompleteCallback(nullptr) {
 }
 
 void TimerManager::update(TimerState& currentState,
@@ -30,30 +54,22 @@ void TimerManager::update(TimerState& currentState,
 }
 
 void TimerManager::updateTimer() {
-    if (timerStartTime == 0) return; // Timer not started
+    if (!timerActive) return; // Timer not started
     
-    uint32_t currentTime = millis();
-    uint32_t elapsed = (currentTime - timerStartTime) / 1000;
+    // Whole seconds elapsed; the display rounds remaining time up, as before
+    uint32_t elapsed = (uint32_t)(getElapsedUs() / 1000000ULL);
     
     // Calculate remaining time
     if (elapsed >= timerDuration) {
         // Timer has fully completed - ensure it shows 00:00
         timerRemaining = 0;
         
-        // CRITICAL: Set timerCompletionTime when timer completes
-        if (timerCompletionTime == 0) {
+        // CRITICAL: Start the completion sequence once when the timer completes
+        if (!alarmActive) {
             timerCompleted = true;
+            alarmActive = true;
             timerCompletionTime = millis(); // Record when we reached 00:00
-            Serial.println("╔════════════════════════════════════════╗");
-            Serial.print("║ TIMER COMPLETED! State: ");
-            Serial.print("               ║");
-            Serial.print("║ timerCompletionTime set to: ");
-            Serial.print(timerCompletionTime);
-            Serial.println("    ║");
-            Serial.print("║ beepState: ");
-            Serial.print(beepState);
-            Serial.println("                           ║");
-            Serial.println("╚════════════════════════════════════════╝");
+            TRACE(TRACE_TIMER_COMPLETED, timerDuration, timerCompletionTime);
         }
     } else {
         // Update remaining time - ensure it counts down to 0
@@ -67,7 +83,7 @@ void TimerManager::handleTimerCompletion(TimerState& currentState,
                                         uint8_t& completedPomodoros,
                                         bool& needsRedraw) {
     // Check if timer has completed and we need to beep
-    if (timerCompletionTime == 0) return; // No completion to handle
+    if (!alarmActive) return; // No completion to handle
     
     // Only handle completion for timer states
     if (currentState != STATE_RUNNING && currentState != STATE_SHORT_BREAK && currentState != STATE_LONG_BREAK) {
@@ -75,117 +91,129 @@ void TimerManager::handleTimerCompletion(TimerState& currentState,
     }
     
     uint32_t elapsedSinceCompletion = millis() - timerCompletionTime;
+    uint32_t now = millis();
     
-    Serial.print("→ handleTimerCompletion: elapsed=");
-    Serial.print(elapsedSinceCompletion);
-    Serial.print("ms, beepState=");
-    Serial.print(beepState);
-    Serial.print(", currentState=");
-    Serial.println(currentState);
-    
-    // Wait 1 second to ensure 00:00 is displayed, then beep
-    if (elapsedSinceCompletion >= 1000 && beepState == 0) {
-        Serial.println("╔═══════════════════════════════════════════╗");
-        Serial.println("║  🔊 STARTING BUZZER SEQUENCE              ║");
-        Serial.print("║  State: ");
-        Serial.print(currentState);
-        Serial.println("                              ║");
-        Serial.println("╚═══════════════════════════════════════════╝");
+    if (beepState == 0) {
+        // Wait 1 second to ensure 00:00 is displayed, then beep
+        if (elapsedSinceCompletion < 1000) return;
         
-        // Set flag to prevent re-entry
+        TRACE(TRACE_ALARM_START, currentState, 0);
         beepState = 1;
+        lastBeepTime = now;
+        startBeepStep(0);
+        return;
+    }
+    
+    if (beepState <= BEEP_STEP_COUNT) {
+        // Advance to the next step once the current one has run its course
+        const BeepStep& step = BEEP_PATTERN[beepState - 1];
+        if (now - lastBeepTime < step.durationMs) return;
         
-        // CRITICAL: Ensure speaker is ready
-        M5Dial.Speaker.end(); // Stop any previous tone
-        delay(50);
-        M5Dial.update();
-        
-        Serial.println("Playing beeps with speaker resets...");
-        
-        // Play 5-beep pattern with explicit speaker management
-        for (int i = 0; i < 4; i++) {
-            Serial.print("Beep ");
-            Serial.println(i + 1);
-            M5Dial.Speaker.tone(3000, 250);
-            uint32_t startBeep = millis();
-            while (millis() - startBeep < 250) {
-                M5Dial.update();
-                delay(1);
-            }
-            M5Dial.Speaker.end(); // Explicitly stop
-            uint32_t startPause = millis();
-            while (millis() - startPause < 300) {
-                M5Dial.update();
-                delay(1);
-            }
+        lastBeepTime += step.durationMs; // Keep step boundaries exact even if the loop was late
+        beepState++;
+        if (beepState <= BEEP_STEP_COUNT) {
+            startBeepStep(beepState - 1);
+            return;
         }
-        
-        // Final longer beep
-        Serial.println("Final beep");
-        M5Dial.Speaker.tone(3000, 400);
-        uint32_t startFinalBeep = millis();
-        while (millis() - startFinalBeep < 400) {
-            M5Dial.update();
-            delay(1);
+    }
+    
+    // Sequence finished (or silenced)
+    hal.speaker->stop();
+    TRACE(TRACE_ALARM_DONE, currentState, 0);
+    
+    // Reset completion flag
+    alarmActive = false;
+    beepState = 0; // Reset immediately before state switch
+    
+    // Switch to next state
+    completeSession(currentState, settings, completedPomodoros, needsRedraw);
+}
+
+void TimerManager::startBeepStep(uint8_t index) {
+    const BeepStep& step = BEEP_PATTERN[index];
+    TRACE(TRACE_ALARM_STEP, index, step.frequency);
+    if (step.frequency > 0) {
+        hal.speaker->tone(step.frequency, step.durationMs);
+    } else {
+        hal.speaker->stop(); // Explicitly stop
+    }
+}
+
+void TimerManager::silenceAlarm() {
+    if (!isAlarmActive()) return;
+    
+    // Skip the rest of the pattern; the next update() switches sessions
+    hal.speaker->stop();
+    TRACE(TRACE_ALARM_SILENCED, beepState, 0);
+    beepState = BEEP_STEP_COUNT + 1;
+}
+
+uint64_t TimerManager::getElapsedUs() const {
+    if (!timerActive) return 0;
+    uint64_t elapsed = elapsedBeforeSegmentUs;
+    if (segmentRunning) {
+        elapsed += nowUs() - segmentStartUs; // Currently running segment
+    }
+    return elapsed;
+}
+
+float TimerManager::getRemainingExact() const {
+    if (!timerActive) return (float)timerRemaining;
+    uint64_t durationUs = (uint64_t)timerDuration * 1000000ULL;
+    uint64_t elapsed = getElapsedUs();
+    if (elapsed >= durationUs) return 0.0f;
+    return (float)(durationUs - elapsed) / 1000000.0f;
+}
+
+float TimerManager::getProgress() const {
+    if (timerDuration == 0) return 0.0f;
+    return 1.0f - getRemainingExact() / (float)timerDuration;
+}
+
+uint32_t TimerManager::getMsUntilNextEvent(TimerState currentState) const {
+    if (currentState != STATE_RUNNING && currentState != STATE_SHORT_BREAK && currentState != STATE_LONG_BREAK) {
+        return UINT32_MAX; // Nothing ticks while idle, paused or in settings
+    }
+    
+    uint32_t now = millis();
+    if (alarmActive) {
+        if (beepState == 0) {
+            // 00:00 hold before the alarm starts
+            uint32_t sinceCompletion = now - timerCompletionTime;
+            return sinceCompletion >= 1000 ? 0 : 1000 - sinceCompletion;
         }
-        M5Dial.Speaker.end(); // Stop speaker
-        Serial.println("All beeps complete");
-        
-        Serial.println("╔═══════════════════════════════════════════╗");
-        Serial.println("║  ✓ BUZZER COMPLETE - SWITCHING STATE     ║");
-        Serial.println("╚═══════════════════════════════════════════╝");
-        
-        // Reset completion flag
-        timerCompletionTime = 0;
-        beepState = 0; // Reset immediately before state switch
-        
-        Serial.print("Before completeSession: timerCompletionTime=");
-        Serial.print(timerCompletionTime);
-        Serial.print(", beepState=");
-        Serial.println(beepState);
-        
-        // Switch to next state
-        completeSession(currentState, settings, completedPomodoros, needsRedraw);
-        
-        Serial.print("After completeSession: timerCompletionTime=");
-        Serial.print(timerCompletionTime);
-        Serial.print(", beepState=");
-        Serial.print(beepState);
-        Serial.print(", currentState=");
-        Serial.println(currentState);
-        Serial.println("═══════════════════════════════════════════\n");
+        if (beepState <= BEEP_STEP_COUNT) {
+            uint32_t inStep = now - lastBeepTime;
+            uint32_t stepMs = BEEP_PATTERN[beepState - 1].durationMs;
+            return inStep >= stepMs ? 0 : stepMs - inStep;
+        }
+        return 0; // Sequence done, session switch pending
     }
+    
+    if (!timerActive) return UINT32_MAX;
+    
+    // Next whole-second boundary of elapsed time
+    uint32_t intoSecondMs = (uint32_t)((getElapsedUs() / 1000ULL) % 1000ULL);
+    return 1000 - intoSecondMs;
 }
 
 void TimerManager::start(uint32_t duration, TimerState& currentState) {
-    Serial.println("\n▶▶▶ startTimer() CALLED ◀◀◀");
-    Serial.print("  Duration: ");
-    Serial.print(duration);
-    Serial.print("s, State: ");
-    Serial.println(currentState);
-    
     timerDuration = duration;
     timerRemaining = duration;
-    timerStartTime = millis();
+    elapsedBeforeSegmentUs = 0;
+    segmentStartUs = nowUs();
+    segmentRunning = true;
+    timerActive = true;
     timerCompleted = false;
-    timerCompletionTime = 0; // ALWAYS reset this
+    alarmActive = false; // ALWAYS reset this
     beepState = 0; // ALWAYS reset this
     lastBeepTime = 0;
     
-    Serial.print("  Reset flags: timerCompletionTime=");
-    Serial.print(timerCompletionTime);
-    Serial.print(", beepState=");
-    Serial.println(beepState);
-    
     if (currentState == STATE_IDLE || currentState == STATE_PAUSED) {
         currentState = STATE_RUNNING;
         lastPomodoroDuration = duration;
-        Serial.println("  Changed state to RUNNING");
-    } else {
-        Serial.print("  Keeping state as: ");
-        Serial.println(currentState);
     }
-    Serial.println("▶▶▶ startTimer() DONE ◀◀◀\n");
+    TRACE(TRACE_TIMER_START, currentState, duration);
 }
 
 void TimerManager::pause(TimerState& currentState) {
@@ -193,26 +221,71 @@ void TimerManager::pause(TimerState& currentState) {
         // Store the current state before pausing
         stateBeforePause = currentState;
         currentState = STATE_PAUSED;
-        // Don't update timerStartTime, so we can resume from where we paused
+        // Bank the exact time run so far; nothing is rounded away
+        if (segmentRunning) elapsedBeforeSegmentUs += nowUs() - segmentStartUs;
+        segmentRunning = false;
     }
 }
 
 void TimerManager::resume(TimerState& currentState) {
     if (currentState == STATE_PAUSED) {
-        // Recalculate start time based on remaining time
-        timerStartTime = millis() - ((timerDuration - timerRemaining) * 1000);
+        // Start a new running segment; banked time carries over exactly
+        segmentStartUs = nowUs();
+        segmentRunning = true;
         
         // Restore the state that was active before pausing
         currentState = stateBeforePause;
     }
 }
 
+void TimerManager::saveSession(TimerState currentState, SessionSnapshot& session) const {
+    bool inProgress = timerActive &&
+                      (currentState == STATE_RUNNING || currentState == STATE_PAUSED ||
+                       currentState == STATE_SHORT_BREAK || currentState == STATE_LONG_BREAK);
+    session.state = inProgress ? currentState : STATE_IDLE;
+    session.stateBeforePause = stateBeforePause;
+    session.completedPomodoros = 0;
+    session.pomodorosSinceLongBreak = pomodorosSinceLongBreak;
+    session.duration = inProgress ? timerDuration : 0;
+    session.elapsedMs = inProgress ? (uint32_t)(getElapsedUs() / 1000ULL) : 0;
+    session.lastPomodoroDuration = lastPomodoroDuration;
+}
+
+void TimerManager::restoreSession(const SessionSnapshot& session, uint32_t downtimeMs,
+                                  TimerState& currentState) {
+    currentState = (TimerState)session.state;
+    stateBeforePause = (TimerState)session.stateBeforePause;
+    pomodorosSinceLongBreak = session.pomodorosSinceLongBreak;
+    lastPomodoroDuration = session.lastPomodoroDuration;
+    timerDuration = session.duration;
+    
+    // Time spent powered off counts only if the session was counting
+    uint64_t elapsedMs = session.elapsedMs;
+    if (currentState != STATE_PAUSED) elapsedMs += downtimeMs;
+    elapsedBeforeSegmentUs = elapsedMs * 1000ULL;
+    segmentStartUs = nowUs();
+    segmentRunning = currentState != STATE_PAUSED;
+    timerActive = true;
+    timerCompleted = false;
+    alarmActive = false;
+    beepState = 0;
+    lastBeepTime = 0;
+    
+    // A session that ran out while the device was off completes (with its alarm) on the next update
+    uint32_t elapsed = (uint32_t)(elapsedMs / 1000ULL);
+    timerRemaining = elapsed >= timerDuration ? 0 : timerDuration - elapsed;
+    TRACE(TRACE_SESSION_RESUMED, currentState, timerRemaining);
+}
+
 void TimerManager::reset(TimerState& currentState, PomodoroSettings& settings) {
     timerRemaining = settings.workDuration;
     timerDuration = settings.workDuration;
-    timerStartTime = 0;
+    timerActive = false;
+    segmentStartUs = 0;
+    segmentRunning = false;
+    elapsedBeforeSegmentUs = 0;
     timerCompleted = false;
-    timerCompletionTime = 0;
+    alarmActive = false;
     beepState = 0;
     lastBeepTime = 0;
     currentState = STATE_IDLE;
@@ -224,18 +297,19 @@ void TimerManager::completeSession(TimerState& currentState,
                                    bool& needsRedraw) {
     // Note: Beep sound is now played in handleTimerCompletion() before calling this function
     // This ensures the sequence: Show 00:00 -> Beep -> Switch states
-    
-    Serial.print("completeSession called: currentState=");
-    Serial.println(currentState);
+    TimerState finished = currentState;
+    uint32_t finishedDuration = timerDuration;
     
     if (currentState == STATE_RUNNING) {
         completedPomodoros++;
+        pomodorosSinceLongBreak++;
         Serial.print("Pomodoro completed! Total: ");
         Serial.println(completedPomodoros);
         
         // Check if it's time for a long break
-        if (completedPomodoros % settings.pomodorosUntilLongBreak == 0) {
+        if (pomodorosSinceLongBreak >= settings.pomodorosUntilLongBreak) {
             Serial.println("Starting LONG BREAK");
+            pomodorosSinceLongBreak = 0;
             currentState = STATE_LONG_BREAK;
             start(getLongBreakDuration(settings), currentState); // Long break = pomodoro time
         } else {
@@ -264,6 +338,10 @@ void TimerManager::completeSession(TimerState& currentState,
         currentState = STATE_IDLE;
         reset(currentState, settings);
     }
+    TRACE(TRACE_SESSION_COMPLETE, currentState, completedPomodoros);
+    if (sessionCompleteCallback) {
+        sessionCompleteCallback(finished, finishedDuration);
+    }
     
     needsRedraw = true; // Ensure display updates after state change
 }
@@ -7,8 +7,9 @@
 #define TIMER_MANAGER_H
 
 #include <Arduino.h>
-#include <M5Dial.h>
+#include <M5GFX.h>
 #include "config.h"
+#include "hal/Hal.h"
 #include "types.h"
 
 class TimerManager {
@@ -33,21 +34,60 @@ public:
     uint32_t getDuration() const { return timerDuration; }
     bool isCompleted() const { return timerCompleted; }
     
+    // Sub-second timing for smooth progress rendering
+    uint64_t getElapsedUs() const;
+    float getRemainingExact() const;  // Seconds, fractional
+    float getProgress() const;        // 0.0 at start, 1.0 at completion
+    
+    // Completion alarm (runs from update() without blocking the loop)
+    bool isAlarmActive() const { return alarmActive; }
+    void silenceAlarm();
+    
+    // Milliseconds until update() has work to do (next second boundary or beep step)
+    uint32_t getMsUntilNextEvent(TimerState currentState) const;
+    
+    // Called from update() with each session that ran to completion (nullptr = none)
+    void setSessionCompleteCallback(void (*callback)(TimerState finished, uint32_t duration)) {
+        sessionCompleteCallback = callback;
+    }
+    
+    // Session checkpointing (see SessionCheckpoint.h); completedPomodoros is left to the caller
+    void saveSession(TimerState currentState, SessionSnapshot& session) const;
+    // Continue a checkpointed session; downtimeMs is counted as elapsed unless it was paused
+    void restoreSession(const SessionSnapshot& session, uint32_t downtimeMs, TimerState& currentState);
+    
     // Setters for dial adjustments in idle state
     void setRemaining(uint32_t remaining) { timerRemaining = remaining; }
     void setDuration(uint32_t duration) { timerDuration = duration; }
     
 private:
     // Timer state variables
-    uint32_t timerStartTime;
+    // Elapsed time is kept in microseconds: banked time from previous running
+    // segments plus the segment in progress (only while segmentRunning; any
+    // clock reading, 0 included, is a valid segment start)
+    uint64_t segmentStartUs;
+    uint64_t elapsedBeforeSegmentUs;
+    bool segmentRunning;
+    bool timerActive;
     uint32_t timerRemaining;
     uint32_t timerDuration;
     uint32_t lastPomodoroDuration;
+    uint8_t pomodorosSinceLongBreak; // Position in the cycle (completedPomodoros wraps at 256)
     TimerState stateBeforePause;
     bool timerCompleted;
-    uint32_t timerCompletionTime;
-    uint8_t beepState;
-    uint32_t lastBeepTime;
+    bool alarmActive;               // Reached 00:00: hold, alarm, then switch sessions
+    uint32_t timerCompletionTime;   // millis() at 00:00 (any value, 0 included, is valid)
+    uint8_t beepState;      // 0 = not started, 1..BEEP_STEP_COUNT = current step, beyond = done
+    uint32_t lastBeepTime;  // Start time of the current beep step
+    void (*sessionCompleteCallback)(TimerState finished, uint32_t duration);
+    
+    // Buzzer sequence
+    struct BeepStep {
+        uint16_t frequency;   // Hz, 0 = silence
+        uint16_t durationMs;
+    };
+    static const BeepStep BEEP_PATTERN[];
+    static const uint8_t BEEP_STEP_COUNT;
     
     // Internal helper functions
     void updateTimer();
@@ -55,6 +95,7 @@ private:
                                PomodoroSettings& settings,
                                uint8_t& completedPomodoros,
                                bool& needsRedraw);
+    void startBeepStep(uint8_t index);
     void completeSession(TimerState& currentState,
                         PomodoroSettings& settings,
                         uint8_t& completedPomodoros,
@@ -0,0 +1,57 @@
+/**
+ * Event Tracer Implementation
+ */
+
+#include "Trace.h"
+
+// Indexed by TraceEvent
+static const TraceEventInfo TRACE_EVENT_INFO[TRACE_EVENT_COUNT] = {
+    { "none",             nullptr,   nullptr },
+    { "timer_start",      "state",   "duration_s" },
+    { "timer_completed",  "duration_s", "completion_ms" },
+    { "alarm_start",      "state",   nullptr },
+    { "alarm_step",       "step",    "frequency_hz" },
+    { "alarm_done",       "state",   nullptr },
+    { "alarm_silenced",   "step",    nullptr },
+    { "session_complete", "state",   "completed" },
+    { "redraw",           "state",   nullptr },
+    { "redraw",           "state",   "bytes_pushed" },
+    { "screen_clear",     "color",   nullptr },
+    { "icon_draw",        "icon",    "bg_color" },
+    { "session_resumed",  "state",   "remaining_s" },
+    { "journal_append",   "state",   "sequence" },
+    { "history_append",   "state",   "bytes" }
+};
+
+const TraceEventInfo& getTraceEventInfo(uint16_t event) {
+    static const TraceEventInfo unknown = { "unknown", "arg0", "arg1" };
+    return event < TRACE_EVENT_COUNT ? TRACE_EVENT_INFO[event] : unknown;
+}
+
+#if ENABLE_TRACE
+
+Tracer tracer;
+
+uint32_t Tracer::dump(Writer write, void* context) const {
+    uint32_t end = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+    uint32_t count = end < CAPACITY ? end : CAPACITY;
+
+    TraceDumpHeader header;
+    memcpy(header.magic, "PTRC", 4);
+    header.version = TRACE_DUMP_VERSION;
+    header.recordSize = sizeof(TraceRecord);
+    header.count = count;
+    header.overwritten = end - count;
+    write((const uint8_t*)&header, sizeof(header), context);
+
+    // Oldest record first; at most two contiguous runs of the ring
+    uint32_t first = (end - count) & (CAPACITY - 1);
+    uint32_t run = count < CAPACITY - first ? count : CAPACITY - first;
+    write((const uint8_t*)&records[first], run * sizeof(TraceRecord), context);
+    if (run < count) {
+        write((const uint8_t*)&records[0], (count - run) * sizeof(TraceRecord), context);
+    }
+    return count;
+}
+
+#endif // ENABLE_TRACE
@@ -0,0 +1,102 @@
+/**
+ * Event Tracer
+ * Fixed-size binary records (timestamp, event ID, two args) in a RAM ring
+ * buffer, replacing Serial logging in hot paths. Recording is one atomic
+ * increment and a 12-byte store; the oldest records are overwritten.
+ * Dumps are decoded on the host (program decode, see hal/host/TraceDecoder.h).
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Event IDs are part of the dump format: append only, never renumber
+enum TraceEvent : uint16_t {
+    TRACE_NONE = 0,
+    TRACE_TIMER_START,        // arg0 = state, arg1 = duration (s)
+    TRACE_TIMER_COMPLETED,    // arg0 = duration (s), arg1 = completion time (ms)
+    TRACE_ALARM_START,        // arg0 = state
+    TRACE_ALARM_STEP,         // arg0 = step index, arg1 = frequency (Hz, 0 = silence)
+    TRACE_ALARM_DONE,         // arg0 = state
+    TRACE_ALARM_SILENCED,     // arg0 = steps started (0 = silenced before the first)
+    TRACE_SESSION_COMPLETE,   // arg0 = next state, arg1 = completed pomodoros
+    TRACE_REDRAW_BEGIN,       // arg0 = state
+    TRACE_REDRAW_END,         // arg0 = state, arg1 = SPI bytes pushed so far
+    TRACE_SCREEN_CLEAR,       // arg0 = color
+    TRACE_ICON_DRAW,          // arg0 = icon, arg1 = background color
+    TRACE_SESSION_RESUMED,    // arg0 = state, arg1 = remaining (s)
+    TRACE_JOURNAL_APPEND,     // arg0 = state, arg1 = checkpoint sequence
+    TRACE_HISTORY_APPEND,     // arg0 = finished session state, arg1 = bytes written
+    TRACE_EVENT_COUNT
+};
+
+struct TraceRecord {
+    uint32_t timestampUs;     // micros(); wraps every ~71 minutes
+    uint16_t event;           // TraceEvent
+    uint16_t arg0;
+    uint32_t arg1;
+};
+
+// Dump layout: header followed by `count` records, oldest first (little-endian)
+struct TraceDumpHeader {
+    char magic[4];            // "PTRC"
+    uint16_t version;
+    uint16_t recordSize;      // sizeof(TraceRecord)
+    uint32_t count;
+    uint32_t overwritten;     // Records lost to wrap-around before this dump
+};
+
+static const uint16_t TRACE_DUMP_VERSION = 1;
+
+// Event name and argument names (nullptr = unused), for decoders
+struct TraceEventInfo {
+    const char* name;
+    const char* arg0;
+    const char* arg1;
+};
+const TraceEventInfo& getTraceEventInfo(uint16_t event);
+
+#if ENABLE_TRACE
+
+class Tracer {
+public:
+    static const uint32_t CAPACITY = 512;   // Power of two (6 KB)
+
+    Tracer() : head(0) {}
+
+    // Safe from any task or ISR
+    inline void IRAM_ATTR record(TraceEvent event, uint16_t arg0, uint32_t arg1) {
+        uint32_t index = __atomic_fetch_add(&head, 1, __ATOMIC_RELAXED);
+        TraceRecord& r = records[index & (CAPACITY - 1)];
+        r.timestampUs = micros();
+        r.event = event;
+        r.arg0 = arg0;
+        r.arg1 = arg1;
+    }
+
+    // Stream a dump (header, then records oldest first) through write; returns
+    // the record count. Records written meanwhile may appear torn - dump from
+    // a quiet moment.
+    typedef void (*Writer)(const uint8_t* data, size_t length, void* context);
+    uint32_t dump(Writer write, void* context) const;
+
+    void clear() { __atomic_store_n(&head, 0, __ATOMIC_RELAXED); }
+
+private:
+    TraceRecord records[CAPACITY];
+    uint32_t head;            // Total records ever written (free-running)
+};
+
+extern Tracer tracer;
+
+#define TRACE(event, arg0, arg1) tracer.record((event), (uint16_t)(arg0), (uint32_t)(arg1))
+
+#else
+
+#define TRACE(event, arg0, arg1) do {} while (0)
+
+#endif // ENABLE_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,269 @@
+/**
+ * UI Widgets Implementation
+ * Setters compare against the bound values; paint() draws through Display's
+ * primitives, which record the touched region for the next flush
+ */
+
+#include "Widget.h"
+#include "Display.h"
+#include "Trace.h"
+
+// Copy text into a fixed buffer; returns true if it differs from what was there
+static bool storeText(char* dest, size_t size, const char* text) {
+    if (strncmp(dest, text, size - 1) == 0) return false;
+    strncpy(dest, text, size - 1);
+    dest[size - 1] = '\0';
+    return true;
+}
+
+// ==================== WIDGET ====================
+Widget::Widget(const UiRect& box)
+    : next(nullptr),
+      box(box),
+      dirty(true) {
+}
+
+// ==================== LABEL ====================
+LabelWidget::LabelWidget(const UiRegion& region, int16_t linePitch)
+    : Widget(region.box),
+      anchor(region.text),
+      linePitch(linePitch),
+      fgColor(0),
+      bgColor(0) {
+    text[0] = '\0';
+}
+
+void LabelWidget::set(const char* newText, uint16_t fg, uint16_t bg) {
+    bool changed = storeText(text, sizeof(text), newText);
+    if (changed || fg != fgColor || bg != bgColor) dirty = true;
+    fgColor = fg;
+    bgColor = bg;
+}
+
+void LabelWidget::paint(Display& display) {
+    display.fillBox(box, bgColor);
+    display.setTextStyle(anchor, fgColor);
+
+    // One drawText per line
+    char line[TEXT_LEN];
+    const char* start = text;
+    int16_t y = anchor.y;
+    while (true) {
+        const char* end = strchr(start, '\n');
+        size_t len = end ? (size_t)(end - start) : strlen(start);
+        if (len >= sizeof(line)) len = sizeof(line) - 1;
+        memcpy(line, start, len);
+        line[len] = '\0';
+        if (len > 0) display.drawText(line, anchor.x, y);
+        if (!end) break;
+        start = end + 1;
+        y += linePitch;
+    }
+}
+
+// ==================== COUNTDOWN ====================
+CountdownWidget::CountdownWidget(const UiRegion& region)
+    : Widget(region.box),
+      anchor(region.text),
+      drawnLength(0),
+      fgColor(0),
+      bgColor(0) {
+    text[0] = '\0';
+    memset(drawn, 0, sizeof(drawn));
+}
+
+void CountdownWidget::set(uint32_t seconds, uint16_t fg, uint16_t bg) {
+    char newText[Display::TIME_TEXT_SIZE];
+    Display::formatTime(seconds, newText, sizeof(newText));
+    bool changed = storeText(text, sizeof(text), newText);
+    if (fg != fgColor || bg != bgColor) {
+        // Every cell carries its own background
+        memset(drawn, 0, sizeof(drawn));
+        changed = true;
+    }
+    fgColor = fg;
+    bgColor = bg;
+    if (changed) dirty = true;
+}
+
+void CountdownWidget::invalidate() {
+    Widget::invalidate();
+    memset(drawn, 0, sizeof(drawn));
+    drawnLength = 0;
+}
+
+void CountdownWidget::paint(Display& display) {
+    display.setTextStyle(anchor, fgColor);
+
+    uint8_t len = strlen(text);
+    if (len != drawnLength) {
+        // Layout shifted - clear the whole box and repaint every cell
+        display.fillBox(box, bgColor);
+        memset(drawn, 0, sizeof(drawn));
+        drawnLength = len;
+    }
+
+    // Fixed-width font: each character owns one cell of the centered string
+    int16_t cellWidth = display.gfx().textWidth("0");
+    int16_t startX = anchor.x - (cellWidth * len) / 2;
+    for (uint8_t i = 0; i < len; i++) {
+        if (drawn[i] == text[i]) continue;
+        drawn[i] = text[i];
+        int16_t cellX = startX + i * cellWidth;
+
+        // Blit the pre-rendered cell (it includes its own background)
+        if (display.drawGlyph(text[i], fgColor, bgColor, cellX, box.y)) continue;
+        char ch[2] = {text[i], '\0'};
+        display.fillRegion(cellX, box.y, cellWidth, box.h, bgColor);
+        display.drawText(ch, cellX + cellWidth / 2, anchor.y);
+    }
+}
+
+// ==================== ICON ====================
+IconWidget::IconWidget(const UiRegion& region, IconId id, int16_t size,
+                       const char* fallbackGlyph, uint16_t fallbackColor)
+    : Widget(region.box),
+      anchor(region.text),
+      id(id),
+      size(size),
+      fallbackGlyph(fallbackGlyph),
+      fallbackColor(fallbackColor),
+      fgColor(0),
+      bgColor(0) {
+}
+
+void IconWidget::set(uint16_t fg, uint16_t bg) {
+    if (fg != fgColor || bg != bgColor) dirty = true;
+    fgColor = fg;
+    bgColor = bg;
+}
+
+void IconWidget::paint(Display& display) {
+    TRACE(TRACE_ICON_DRAW, id, bgColor);
+    int16_t x = anchor.x - size / 2;
+    int16_t y = anchor.y - size / 2;
+
+    // The blit covers the icon square; clear the rest of a larger box first
+    bool coversBox = box.x == x && box.y == y && box.w == size && box.h == size;
+    if (!coversBox) display.fillBox(box, bgColor);
+
+    // Blit the cached icon; fall back if it could not be loaded
+    if (display.drawIcon(id, bgColor, x, y)) return;
+    if (fallbackGlyph) {
+        if (coversBox) display.fillBox(box, bgColor);
+        display.setTextStyle(anchor, fgColor);
+        display.drawText(fallbackGlyph, anchor.x, anchor.y);
+    } else {
+        display.fillRegion(x, y, size, size, fallbackColor);
+    }
+}
+
+// ==================== ARC ====================
+static const int16_t RING_EXTENT = CIRCLE_RADIUS + CIRCLE_THICKNESS / 2 + 1;   // Edge pixels included
+
+ArcWidget::ArcWidget()
+    : Widget({ CENTER_X - RING_EXTENT, CENTER_Y - RING_EXTENT, 2 * RING_EXTENT, 2 * RING_EXTENT }),
+      step(0),
+      drawnStep(-1),
+      arcColor(0),
+      trackColor(0),
+      bgColor(0) {
+}
+
+void ArcWidget::set(uint16_t newStep, uint16_t arc, uint16_t track, uint16_t bg) {
+    if (arc != arcColor || track != trackColor || bg != bgColor) {
+        drawnStep = -1;     // Recolor the whole ring
+        dirty = true;
+    }
+    if (newStep != step) dirty = true;
+    step = newStep;
+    arcColor = arc;
+    trackColor = track;
+    bgColor = bg;
+}
+
+void ArcWidget::invalidate() {
+    Widget::invalidate();
+    drawnStep = -1;
+}
+
+void ArcWidget::paint(Display& display) {
+    display.drawProgressArc(step, drawnStep, arcColor, trackColor, bgColor);
+    drawnStep = step;
+}
+
+// ==================== LIST ====================
+static UiRect listBox(const UiList& layout, uint8_t rows) {
+    UiRect first = listRowBox(layout, 0);
+    UiRect last = listRowBox(layout, rows - 1);
+    return { first.x, first.y, first.w, (int16_t)(rectBottom(last) - first.y) };
+}
+
+ListWidget::ListWidget(const UiList& layout, uint8_t rows)
+    : Widget(listBox(layout, rows)),
+      layout(layout),
+      rowCount(rows > MAX_ROWS ? MAX_ROWS : rows) {
+    memset(this->rows, 0, sizeof(this->rows));
+    invalidate();
+}
+
+void ListWidget::setRow(uint8_t row, const char* label, const char* value, uint16_t fg, uint16_t bg) {
+    if (row >= rowCount) return;
+    Row& r = rows[row];
+
+    char text[TEXT_LEN];
+    snprintf(text, sizeof(text), "%s%s", label, value);
+    size_t labelLen = strlen(label);
+    uint8_t valueStart = labelLen < sizeof(text) ? labelLen : sizeof(text) - 1;
+
+    size_t oldLen = strlen(r.text);
+    bool sameLabel = valueStart == r.valueStart && strncmp(r.text, text, valueStart) == 0;
+    bool changed = storeText(r.text, sizeof(r.text), text);
+    RowDamage damage = ROW_CLEAN;
+    if (fg != r.fgColor || bg != r.bgColor || !sameLabel || strlen(r.text) != oldLen) {
+        damage = ROW_FULL;
+    } else if (changed) {
+        damage = ROW_VALUE;
+    }
+    if (damage > r.damage) r.damage = damage;
+    if (r.damage != ROW_CLEAN) dirty = true;
+    r.valueStart = valueStart;
+    r.fgColor = fg;
+    r.bgColor = bg;
+}
+
+void ListWidget::invalidate() {
+    Widget::invalidate();
+    for (uint8_t i = 0; i < rowCount; i++) rows[i].damage = ROW_FULL;
+}
+
+void ListWidget::paintValue(Display& display, uint8_t row) {
+    const Row& r = rows[row];
+    const UiText& anchor = layout.firstRow.text;
+    UiRect rowBox = listRowBox(layout, row);
+    int16_t textY = listRowTextY(layout, row);
+
+    // Same cells the centered row occupies, so the label's pixels are left untouched
+    display.setTextStyle(anchor, r.fgColor);
+    int16_t cellWidth = display.gfx().textWidth("0");
+    int16_t len = strlen(r.text);
+    int16_t valueX = anchor.x - (cellWidth * len) / 2 + r.valueStart * cellWidth;
+    display.fillRegion(valueX, rowBox.y, (len - r.valueStart) * cellWidth, rowBox.h, r.bgColor);
+
+    UiText valueAnchor = { valueX, textY, top_left, anchor.size };
+    display.setTextStyle(valueAnchor, r.fgColor);
+    display.drawText(r.text + r.valueStart, valueX, textY);
+}
+
+void ListWidget::paint(Display& display) {
+    for (uint8_t i = 0; i < rowCount; i++) {
+        Row& r = rows[i];
+        if (r.damage == ROW_VALUE) paintValue(display, i);
+        if (r.damage == ROW_FULL) {
+            display.fillBox(listRowBox(layout, i), r.bgColor);
+            display.setTextStyle(layout.firstRow.text, r.fgColor);
+            display.drawText(r.text, layout.firstRow.text.x, listRowTextY(layout, i));
+        }
+        r.damage = ROW_CLEAN;
+    }
+}
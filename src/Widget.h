@@ -0,0 +1,152 @@
+/**
+ * UI Widgets
+ * Retained-mode building blocks for the screens. A widget owns a region and
+ * the values last bound to it; a setter that changes anything marks it dirty,
+ * and the renderer only paints dirty widgets, so redraw cost follows what
+ * actually changed. Widgets of a screen are chained through `next`.
+ */
+
+#ifndef WIDGET_H
+#define WIDGET_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "Theme.h"
+#include "IconCache.h"
+
+class Display;
+
+class Widget {
+public:
+    explicit Widget(const UiRect& box);
+    virtual ~Widget() {}
+
+    // Repaint the widget; only called while it is dirty
+    virtual void paint(Display& display) = 0;
+
+    // Forget what is on screen (the screen was cleared): repaint everything next time
+    virtual void invalidate() { dirty = true; }
+
+    bool isDirty() const { return dirty; }
+    void markClean() { dirty = false; }
+    const UiRect& getBox() const { return box; }
+
+    Widget* next;               // Next widget on the same screen
+
+protected:
+    UiRect box;
+    bool dirty;
+};
+
+// Text in a region: the box is cleared, then each '\n' separated line drawn linePitch apart
+class LabelWidget : public Widget {
+public:
+    static const uint8_t TEXT_LEN = 48;     // All lines, separators included
+
+    explicit LabelWidget(const UiRegion& region, int16_t linePitch = 0);
+
+    void set(const char* text, uint16_t fgColor, uint16_t bgColor);
+    void paint(Display& display) override;
+
+private:
+    UiText anchor;
+    int16_t linePitch;
+    char text[TEXT_LEN];
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+// MM:SS countdown: one fixed-width cell per character, only changed cells repainted
+class CountdownWidget : public Widget {
+public:
+    explicit CountdownWidget(const UiRegion& region);
+
+    void set(uint32_t seconds, uint16_t fgColor, uint16_t bgColor);
+    void paint(Display& display) override;
+    void invalidate() override;
+
+private:
+    static const uint8_t CELLS = 5;
+
+    UiText anchor;
+    char text[CELLS + 1];
+    char drawn[CELLS + 1];      // Cell contents on screen ('\0' = unknown)
+    uint8_t drawnLength;
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+// Cached icon centered on the region anchor; without the cache, a glyph or a color square
+class IconWidget : public Widget {
+public:
+    IconWidget(const UiRegion& region, IconId id, int16_t size,
+               const char* fallbackGlyph, uint16_t fallbackColor);
+
+    void set(uint16_t fgColor, uint16_t bgColor);
+    void paint(Display& display) override;
+
+private:
+    UiText anchor;
+    IconId id;
+    int16_t size;
+    const char* fallbackGlyph;  // nullptr = fill the icon square with fallbackColor
+    uint16_t fallbackColor;
+    uint16_t fgColor;
+    uint16_t bgColor;
+};
+
+// Progress ring: after a repaint of the whole ring, only the wedge swept since
+// the last paint is drawn
+class ArcWidget : public Widget {
+public:
+    ArcWidget();
+
+    void set(uint16_t step, uint16_t arcColor, uint16_t trackColor, uint16_t bgColor);
+    void paint(Display& display) override;
+    void invalidate() override;
+
+private:
+    uint16_t step;
+    int32_t drawnStep;          // -1 = repaint the whole ring
+    uint16_t arcColor;
+    uint16_t trackColor;
+    uint16_t bgColor;
+};
+
+// Rows of "label value" text, each repainted only when its text or colors changed.
+// Assumes a fixed-width font: when only the value changed and the row kept its length,
+// the label stays where it is and only the value field is repainted.
+class ListWidget : public Widget {
+public:
+    static const uint8_t MAX_ROWS = 8;
+    static const uint8_t TEXT_LEN = 40;
+
+    ListWidget(const UiList& layout, uint8_t rows);
+
+    void setRow(uint8_t row, const char* label, const char* value, uint16_t fgColor, uint16_t bgColor);
+    void paint(Display& display) override;
+    void invalidate() override;
+
+private:
+    enum RowDamage : uint8_t {
+        ROW_CLEAN,
+        ROW_VALUE,              // Value field only
+        ROW_FULL
+    };
+
+    struct Row {
+        char text[TEXT_LEN];    // Label followed by the value
+        uint8_t valueStart;     // Offset of the value in text
+        uint16_t fgColor;
+        uint16_t bgColor;
+        RowDamage damage;
+    };
+
+    UiList layout;
+    uint8_t rowCount;
+    Row rows[MAX_ROWS];
+
+    void paintValue(Display& display, uint8_t row);
+};
+
+#endif // WIDGET_H
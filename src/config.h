@@ -6,7 +6,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
-#include <M5Dial.h>
+#include <M5GFX.h>
 
 // ==================== DISPLAY DIMENSIONS ====================
 const int16_t SCREEN_WIDTH = 240;
@@ -17,31 +17,94 @@ const int16_t CIRCLE_RADIUS = 90;
 const int16_t CIRCLE_THICKNESS = 8;
 
 // ==================== FEATURE FLAGS ====================
-// Set to true to show the white circle, false to hide it
-const bool SHOW_WHITE_CIRCLE = false;
+// Set to true to show the progress arc on the ring, false to hide it
+const bool SHOW_PROGRESS_ARC = true;
+
+// Progress arc: a gauge on the ring, open at the bottom where the instructions
+// and the gear sit. It advances one angular step at a time, at most one frame
+// per PROGRESS_ARC_FRAME_MS, so short sessions move smoothly between ticks.
+const uint16_t PROGRESS_ARC_SWEEP_DEG = 240;
+const uint16_t PROGRESS_ARC_STEPS = 1024;   // Angular resolution over the sweep
+const uint32_t PROGRESS_ARC_FRAME_MS = 33;  // ~30 FPS max arc updates
 
 // ==================== PERFORMANCE SETTINGS ====================
-// Loop timing (milliseconds)
-const uint8_t LOOP_DELAY_ACTIVE = 10;    // Delay when timer running/settings active
-const uint8_t LOOP_DELAY_IDLE = 20;      // Delay when idle/paused (save CPU)
+// Loop timing (milliseconds) - the loop sleeps until its next deadline or an input
+// interrupt (button, encoder, touch); with nothing scheduled it sleeps indefinitely
+const uint8_t LOOP_DELAY_ACTIVE = 10;    // Input poll interval right after user interaction
+const uint16_t INPUT_ACTIVE_WINDOW_MS = 1500; // Keep polling briskly this long after any input
+const uint8_t SERIAL_POLL_MS = 100;      // Trace builds: Serial has no wake-up, poll for the dump request
+const uint8_t BUTTON_PIN = 42;           // M5Dial BtnA GPIO (wakes the loop on edges)
+
+// Power saving: light sleep between events while Ready or Paused.
+// Note: USB CDC serial output pauses while the chip sleeps.
+const bool ENABLE_LIGHT_SLEEP = true;
 
-// Encoder settings
-const uint8_t ENCODER_DEBOUNCE_MS = 10;  // Minimum time between encoder reads (balanced)
-const int32_t ENCODER_THRESHOLD = 1;      // Minimum encoder delta to process
+// Encoder settings (decoded in a GPIO interrupt, see EncoderCapture)
+const uint8_t ENCODER_PIN_A = 40;        // M5Dial encoder A GPIO
+const uint8_t ENCODER_PIN_B = 41;        // M5Dial encoder B GPIO
+
+// Touch controller (FT3267) interrupt line: pulled low while a finger is down
+const uint8_t TOUCH_INT_PIN = 14;        // M5Dial touch INT GPIO (wakes the chip from light sleep)
 
 // Display optimization
 const uint32_t MIN_REDRAW_INTERVAL_MS = 16; // ~60 FPS max refresh rate
+const bool USE_SPRITE_BUFFER = true;        // Render off-screen, push only the changed region
+
+// Task split: input, timer and alarm stay in the Arduino loop task (core 1) at
+// raised priority; all rendering runs in its own task on core 0.
+// Set to 0 to run everything in loop() (for before/after latency comparisons).
+#ifndef ENABLE_DUAL_CORE
+#define ENABLE_DUAL_CORE 1
+#endif
+const uint8_t CONTROL_TASK_PRIORITY = 3;
+const uint8_t RENDER_TASK_PRIORITY = 1;
+const uint8_t RENDER_TASK_CORE = 0;
+const uint32_t RENDER_TASK_STACK = 8192;
+// Flash journal and history appends (a sector erase takes tens of ms) run in a
+// task of their own below the loop task, in both modes
+const uint8_t STORAGE_TASK_PRIORITY = 1;
+const uint32_t STORAGE_TASK_STACK = 4096;
+
+// Settings persistence (NVS): write once the settings have been left alone this long,
+// so a fast dial spin or a menu session costs one flash write
+const uint32_t SETTINGS_COMMIT_DELAY_MS = 3000;
+
+// Session resume after a reset or power loss: the session is checkpointed to RTC
+// memory every second while counting, and appended to the flash journal on every
+// state change and once a minute. Sessions interrupted for longer than
+// RESUME_MAX_DOWNTIME_S are dropped instead of resumed.
+const uint32_t CHECKPOINT_RTC_INTERVAL_MS = 1000;
+const uint32_t CHECKPOINT_FLASH_INTERVAL_MS = 60000;
+const uint32_t RESUME_MAX_DOWNTIME_S = 30 * 60;
+const uint32_t WALL_CLOCK_MIN_VALID = 1577836800;  // 2020-01-01: earlier readings are an unset RTC
+const uint32_t CHECKPOINT_BUDGET_US_PER_S = 100;   // Checkpoint cost ceiling while counting
+
+// A history append that fails stays queued and is retried this often, up to
+// HISTORY_APPEND_ATTEMPTS times, before the session is counted as lost
+const uint32_t HISTORY_RETRY_MS = 1000;
+const uint8_t HISTORY_APPEND_ATTEMPTS = 3;
 
 // Debug/Performance Monitoring
-const bool ENABLE_PERFORMANCE_MONITOR = false; // Set true to see performance stats in serial
+// Preprocessor flag so the stats and the loop profiler compile out entirely when off
+// (set to 1 here or pass -DENABLE_PERFORMANCE_MONITOR=1 in build_flags)
+#ifndef ENABLE_PERFORMANCE_MONITOR
+#define ENABLE_PERFORMANCE_MONITOR 0
+#endif
 const uint32_t PERF_REPORT_INTERVAL_MS = 5000; // Report every 5 seconds
 
+// Binary event trace (RAM ring buffer, dumped by sending 't' over Serial)
+// (set to 1 here or pass -DENABLE_TRACE=1 in build_flags; env:native turns it on)
+#ifndef ENABLE_TRACE
+#define ENABLE_TRACE 0
+#endif
+
 // ==================== COLOR DEFINITIONS ====================
 const uint16_t COLOR_WORK = TFT_RED;
 const uint16_t COLOR_BREAK = TFT_GREEN;
 const uint16_t COLOR_LONG_BREAK = TFT_CYAN;
 const uint16_t COLOR_BG = TFT_BLACK;
 const uint16_t COLOR_TEXT = TFT_WHITE;
+const uint16_t COLOR_PROGRESS = TFT_WHITE;   // Elapsed part of the progress arc
 const uint16_t COLOR_PROGRESS_BG = 0x2104; // Dark gray
 const uint16_t COLOR_WORK_BG = TFT_RED;    // Red background for pomodoro
 const uint16_t COLOR_SHORT_BREAK_BG = TFT_DARKGREEN; // Dark green background for short break
@@ -0,0 +1,109 @@
+/**
+ * Hardware Abstraction Layer
+ * Thin interfaces over everything the timer touches on the M5Dial, so the
+ * state machine and render pipeline also run on a host (env:native)
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <M5GFX.h>
+
+// Monotonic time source
+class HalClock {
+public:
+    virtual ~HalClock() {}
+    virtual uint32_t millis() = 0;
+    virtual uint64_t micros() = 0;   // 64-bit, never wraps
+    // Battery-backed wall clock in seconds (keeps counting through resets and
+    // power loss); 0 if there is none. Slow (I2C on the device) - never per loop.
+    virtual uint32_t wallSeconds() = 0;
+};
+
+// Buzzer
+class HalSpeaker {
+public:
+    virtual ~HalSpeaker() {}
+    virtual void tone(uint16_t frequency, uint32_t durationMs) = 0;
+    virtual void stop() = 0;
+    virtual bool isPlaying() = 0;
+};
+
+// Button, encoder and touch panel
+class HalInput {
+public:
+    virtual ~HalInput() {}
+    virtual void update() = 0;                            // Poll devices (once per loop)
+    virtual bool isButtonPressed() = 0;
+    virtual bool popEncoderStep(int8_t& step) = 0;        // Oldest queued detent, +1/-1
+    virtual bool getTouchPress(int16_t& x, int16_t& y) = 0; // New touch since last update
+    virtual uint32_t getDroppedSteps() = 0;
+};
+
+// Panel the Display module renders to
+class HalDisplay {
+public:
+    virtual ~HalDisplay() {}
+    virtual LovyanGFX& panel() = 0;
+    virtual void setBrightness(uint8_t level) = 0;        // 0-255
+    // Nobody is looking (host simulator): frames are bound but never rasterized
+    virtual bool isHeadless() { return false; }
+};
+
+// Read-only asset storage (PNG icons)
+class HalFileSystem {
+public:
+    virtual ~HalFileSystem() {}
+    // Read a whole file into a malloc'd buffer (caller frees); nullptr if missing
+    virtual uint8_t* readFile(const char* path, size_t& length) = 0;
+};
+
+// Small persistent records that survive power loss (NVS on the device)
+class HalStorage {
+public:
+    virtual ~HalStorage() {}
+    // Read a record of exactly `length` bytes; false if missing or a different size
+    virtual bool load(const char* key, void* data, size_t length) = 0;
+    virtual bool save(const char* key, const void* data, size_t length) = 0;
+};
+
+// Small RAM region that survives a warm reset (RTC slow memory on the device).
+// Contents are garbage after a power-on reset - callers must validate them.
+class HalRetainedMemory {
+public:
+    virtual ~HalRetainedMemory() {}
+    virtual void* data() = 0;
+    virtual size_t size() = 0;
+};
+
+// Raw flash partition for append-only logs, with NOR semantics: an erased
+// sector reads 0xFF and a write can only clear bits
+static const uint32_t FLASH_SECTOR_SIZE = 4096;
+
+class HalFlash {
+public:
+    virtual ~HalFlash() {}
+    virtual uint32_t size() = 0;                          // Bytes, whole sectors (0 = missing)
+    virtual bool read(uint32_t offset, void* data, size_t length) = 0;
+    virtual bool write(uint32_t offset, const void* data, size_t length) = 0;
+    virtual bool eraseSector(uint32_t offset) = 0;        // offset is sector-aligned
+};
+
+// Active platform, installed once at startup before any module is used
+struct Hal {
+    HalClock* clock;
+    HalSpeaker* speaker;
+    HalInput* input;
+    HalDisplay* display;
+    HalFileSystem* fs;
+    HalStorage* storage;
+    HalRetainedMemory* retained;
+    HalFlash* journal;        // Session checkpoint journal
+    HalFlash* history;        // Completed session log
+};
+
+extern Hal hal;
+
+#endif // HAL_H
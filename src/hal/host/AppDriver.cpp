@@ -0,0 +1,76 @@
+/**
+ * App Driver Implementation
+ */
+
+#include "AppDriver.h"
+
+AppDriver::AppDriver(PomodoroApp& app, HostPlatform& platform)
+    : app(app),
+      platform(platform),
+      steps(0) {
+}
+
+void AppDriver::step() {
+    uint32_t sleepMs = app.step();
+    steps++;
+    // Nothing scheduled: the device would sleep until input, the script moves on
+    platform.clock.advanceMs(sleepMs > 0 ? min(sleepMs, MAX_IDLE_STEP_MS) : 1);
+}
+
+void AppDriver::settle() {
+    // Bounded: a running timer always has another second to draw eventually
+    for (uint8_t i = 0; i < 32; i++) {
+        uint32_t sleepMs = app.step();
+        steps++;
+        if (!app.isRedrawPending()) return;
+        platform.clock.advanceMs(sleepMs > 0 ? min(sleepMs, MAX_IDLE_STEP_MS) : 1);
+    }
+}
+
+void AppDriver::runFor(uint32_t ms) {
+    uint32_t end = platform.clock.millis() + ms;
+    while (platform.clock.millis() < end) {
+        uint32_t sleepMs = app.step();
+        steps++;
+        uint32_t left = end - platform.clock.millis();
+        platform.clock.advanceMs(max<uint32_t>(1, min(sleepMs, left)));
+    }
+    settle();
+}
+
+bool AppDriver::runUntil(TimerState state, uint32_t limitMs) {
+    while (app.getState() != state) {
+        if (platform.clock.millis() >= limitMs) return false;
+        step();
+    }
+    settle();
+    return true;
+}
+
+void AppDriver::shortPress() {
+    platform.input.setButton(true);
+    settle();
+    platform.clock.advanceMs(100);
+    platform.input.setButton(false);
+    settle();
+}
+
+void AppDriver::longPress() {
+    platform.input.setButton(true);
+    runFor(InputHandler::LONG_PRESS_MS + 100);
+    platform.input.setButton(false);
+    settle();
+}
+
+void AppDriver::turnDial(int8_t detents) {
+    int8_t direction = detents < 0 ? -1 : 1;
+    for (int8_t i = 0; i != detents; i += direction) {
+        platform.input.pushEncoderStep(direction);
+    }
+    settle();
+}
+
+void AppDriver::tap(int16_t x, int16_t y) {
+    platform.input.touch(x, y);
+    settle();
+}
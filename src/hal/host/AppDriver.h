@@ -0,0 +1,43 @@
+/**
+ * App Driver (env:native)
+ * Steps a PomodoroApp on the host's virtual clock and scripts its input the
+ * way a user would (presses, holds, dial detents, taps)
+ */
+
+#ifndef APP_DRIVER_H
+#define APP_DRIVER_H
+
+#include "App.h"
+#include "hal/host/HalHost.h"
+
+class AppDriver {
+public:
+    AppDriver(PomodoroApp& app, HostPlatform& platform);
+
+    // Run one loop iteration, then jump the clock to the loop's next deadline
+    // (at most MAX_IDLE_STEP_MS when the loop would wait for input)
+    void step();
+    static const uint32_t MAX_IDLE_STEP_MS = 1000;
+
+    // Step until nothing is left to draw
+    void settle();
+    // Keep stepping for ms of virtual time
+    void runFor(uint32_t ms);
+    // Step until the app reaches state; false if limitMs of virtual time is reached first
+    bool runUntil(TimerState state, uint32_t limitMs);
+
+    // Scripted input (each settles before returning)
+    void shortPress();
+    void longPress();
+    void turnDial(int8_t detents);
+    void tap(int16_t x, int16_t y);
+
+    uint32_t getSteps() const { return steps; }
+
+private:
+    PomodoroApp& app;
+    HostPlatform& platform;
+    uint32_t steps;
+};
+
+#endif // APP_DRIVER_H
@@ -0,0 +1,139 @@
+/**
+ * Progress Arc Benchmark Implementation
+ */
+
+#include "ArcBench.h"
+#include "App.h"
+#include "ProgressArc.h"
+#include "hal/host/AppDriver.h"
+
+// Pixels the old drawCircularProgress filled per draw: the outer disc, then the inner one
+static uint32_t discPixels(int16_t radius) {
+    uint32_t pixels = 0;
+    for (int16_t y = -radius; y <= radius; y++) {
+        for (int16_t x = -radius; x <= radius; x++) {
+            if (x * x + y * y <= radius * radius) pixels++;
+        }
+    }
+    return pixels;
+}
+
+// ==================== SWEEPS ====================
+static int runSweeps(HostPlatform& platform) {
+    static const uint16_t WEDGES[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
+    // Wedges this wide hold enough pixels for the per-degree cost to settle
+    static const uint16_t STEADY_WEDGE = 8;
+
+    ProgressArc arc;
+    if (!arc.build()) {
+        printf("FAIL span table could not be built\n");
+        return 1;
+    }
+    LovyanGFX& panel = platform.display.panel();
+    uint32_t ringPixels = discPixels(CIRCLE_RADIUS + CIRCLE_THICKNESS / 2) +
+                          discPixels(CIRCLE_RADIUS - CIRCLE_THICKNESS / 2);
+    double meanPerDegree = (double)arc.getPixelCount() / PROGRESS_ARC_SWEEP_DEG;
+
+    printf("Span table: %u spans, %u pixels over %u deg in %u steps, %u bytes\n",
+           arc.getSpanCount(), arc.getPixelCount(), PROGRESS_ARC_SWEEP_DEG, PROGRESS_ARC_STEPS,
+           (unsigned)(arc.getSpanCount() * 4 + (PROGRESS_ARC_STEPS + 1) * sizeof(uint16_t)));
+    printf("Old static ring: %lu pixels per draw (two filled discs)\n\n", (unsigned long)ringPixels);
+    printf("%6s %8s %8s %10s %10s %10s\n", "steps", "degrees", "frames", "px/frame", "max px", "px/degree");
+
+    int failed = 0;
+    for (size_t w = 0; w < sizeof(WEDGES) / sizeof(WEDGES[0]); w++) {
+        uint16_t wedge = WEDGES[w];
+        uint32_t frames = 0, total = 0, maxPixels = 0;
+        for (uint16_t from = 0; from < PROGRESS_ARC_STEPS; from += wedge) {
+            int16_t x0 = SCREEN_WIDTH, y0 = SCREEN_HEIGHT, x1 = 0, y1 = 0;
+            uint32_t pixels = arc.draw(panel, from, from + wedge, COLOR_PROGRESS, COLOR_WORK_BG, x0, y0, x1, y1);
+            frames++;
+            total += pixels;
+            if (pixels > maxPixels) maxPixels = pixels;
+        }
+        double degrees = (double)wedge * PROGRESS_ARC_SWEEP_DEG / PROGRESS_ARC_STEPS;
+        double perFrame = (double)total / frames;
+        double perDegree = perFrame / degrees;
+        printf("%6u %8.2f %8lu %10.1f %10lu %10.1f\n", wedge, degrees, (unsigned long)frames,
+               perFrame, (unsigned long)maxPixels, perDegree);
+
+        // Every wedge covers the gauge exactly once
+        if (total != arc.getPixelCount()) {
+            printf("FAIL %u-step wedges drew %lu pixels, the ring has %u\n",
+                   wedge, (unsigned long)total, arc.getPixelCount());
+            failed++;
+        }
+        // Cost per degree is flat once wedges hold a few pixels each
+        if (wedge >= STEADY_WEDGE && maxPixels > 1.25 * meanPerDegree * degrees + 8) {
+            printf("FAIL %u-step wedge: %lu pixels is not proportional to %.2f deg\n",
+                   wedge, (unsigned long)maxPixels, degrees);
+            failed++;
+        }
+    }
+    return failed;
+}
+
+// ==================== SESSIONS ====================
+struct SessionResult {
+    uint32_t frames;
+    uint32_t pixels;
+    uint32_t bytes;
+};
+
+static SessionResult measure(PomodoroApp& app, AppDriver& driver, TimerState state, uint32_t durationS) {
+    Display& display = app.getDisplay();
+    display.resetStats();
+    driver.runFor(durationS * 1000UL - 50);     // Stop short of the completion redraw
+    SessionResult result = { display.getArcFrames(), display.getArcPixels(), display.getBytesPushed() };
+    uint32_t frames = result.frames ? result.frames : 1;
+    printf("%-12s %5lu s %7lu %8.1f %9.1f %9.2f %10.1f %10lu\n",
+           state == STATE_RUNNING ? "focus" : "short break", (unsigned long)durationS,
+           (unsigned long)result.frames, (double)result.frames / durationS,
+           (double)result.pixels / frames, (double)PROGRESS_ARC_SWEEP_DEG / frames,
+           (double)result.pixels / PROGRESS_ARC_SWEEP_DEG, (unsigned long)(result.bytes / durationS));
+    return result;
+}
+
+static int runSessions(HostPlatform& platform) {
+    PomodoroApp app;
+    AppDriver driver(app, platform);
+    app.begin();
+
+    // Shortest sessions the dial allows: 1 minute of focus, then a 12 s break
+    driver.turnDial(-(int8_t)(app.getSettings().workDuration / 60 - 1));
+    uint32_t workS = app.getSettings().workDuration;
+    uint32_t breakS = app.getSettings().shortBreakDuration;
+
+    printf("\n%-12s %7s %7s %8s %9s %9s %10s %10s\n", "session", "length", "frames", "fps",
+           "px/frame", "deg/frame", "px/degree", "SPI B/s");
+    driver.shortPress();
+    SessionResult work = measure(app, driver, STATE_RUNNING, workS);
+    if (!driver.runUntil(STATE_SHORT_BREAK, platform.clock.millis() + 10000)) {
+        printf("FAIL break did not start\n");
+        return 1;
+    }
+    SessionResult rest = measure(app, driver, STATE_SHORT_BREAK, breakS);
+
+    int failed = 0;
+    // Arc-only frames are capped; a second tick may carry the arc along in between
+    double maxFps = 1000.0 / PROGRESS_ARC_FRAME_MS + 1.0;
+    if (work.frames == 0 || rest.frames == 0) { printf("FAIL the arc did not move\n"); failed++; }
+    if ((double)work.frames / workS > maxFps || (double)rest.frames / breakS > maxFps) {
+        printf("FAIL arc updates exceed %.1f fps\n", maxFps);
+        failed++;
+    }
+    // A 12 s break sweeps faster than the cap allows, so it must run at the cap
+    if ((double)rest.frames / breakS < 0.8 * (1000.0 / PROGRESS_ARC_FRAME_MS)) {
+        printf("FAIL short break arc ran below the frame cap\n");
+        failed++;
+    }
+    return failed;
+}
+
+// ==================== BENCHMARK ====================
+int runArcBenchmark(HostPlatform& platform) {
+    int failed = runSweeps(platform);
+    failed += runSessions(platform);
+    printf("Failures: %d\n", failed);
+    return failed;
+}
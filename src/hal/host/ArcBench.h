@@ -0,0 +1,19 @@
+/**
+ * Progress Arc Benchmark (env:native)
+ * - Table: span and pixel counts of the ring's per-step span table
+ * - Sweeps: advances the arc across the whole gauge in wedges of 1 to 1024
+ *   steps and checks the pixels rasterized per frame stay proportional to
+ *   the swept angle (against the old two-disc ring redraw)
+ * - Sessions: runs 1 minute of focus and its 12 s break through the app and
+ *   reports arc frames per second (capped near 30) and pixels per frame
+ */
+
+#ifndef ARC_BENCH_H
+#define ARC_BENCH_H
+
+#include "hal/host/HalHost.h"
+
+// Returns the number of failed checks
+int runArcBenchmark(HostPlatform& platform);
+
+#endif // ARC_BENCH_H
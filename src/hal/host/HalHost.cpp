@@ -0,0 +1,215 @@
+/**
+ * Host HAL Implementation
+ */
+
+#include <Arduino.h>
+#include "HalHost.h"
+
+Hal hal = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+HostSerial Serial;
+
+HostPlatform& installHostHal() {
+    static HostPlatform platform;
+    hal.clock = &platform.clock;
+    hal.speaker = &platform.speaker;
+    hal.input = &platform.input;
+    hal.display = &platform.display;
+    hal.fs = &platform.fs;
+    hal.storage = &platform.storage;
+    hal.retained = &platform.retained;
+    hal.journal = &platform.journal;
+    hal.history = &platform.history;
+    return platform;
+}
+
+// ==================== ARDUINO COMPAT ====================
+uint32_t millis() {
+    return hal.clock->millis();
+}
+
+uint32_t micros() {
+    return (uint32_t)hal.clock->micros();
+}
+
+void delay(uint32_t ms) {
+    // Nobody else advances virtual time, so sleeping is just moving the clock
+    static_cast<HostClock*>(hal.clock)->advanceMs(ms);
+}
+
+// ==================== SPEAKER ====================
+void HostSpeaker::tone(uint16_t frequency, uint32_t durationMs) {
+    playingUntilMs = clock.millis() + durationMs;
+    toneCount++;
+    events.push_back(SpeakerEvent{ clock.millis(), frequency, durationMs });
+}
+
+void HostSpeaker::stop() {
+    playingUntilMs = 0;
+    events.push_back(SpeakerEvent{ clock.millis(), 0, 0 });
+}
+
+// ==================== INPUT ====================
+HostInput::HostInput()
+    : steps(),
+      buttonDown(false),
+      touchPending(false),
+      touchX(0),
+      touchY(0) {
+}
+
+void HostInput::pushEncoderStep(int8_t step) {
+    steps.push(step);
+}
+
+bool HostInput::popEncoderStep(int8_t& step) {
+    return steps.pop(step);
+}
+
+void HostInput::touch(int16_t x, int16_t y) {
+    touchX = x;
+    touchY = y;
+    touchPending = true;
+}
+
+bool HostInput::getTouchPress(int16_t& x, int16_t& y) {
+    if (!touchPending) return false;
+    touchPending = false;
+    x = touchX;
+    y = touchY;
+    return true;
+}
+
+// ==================== DISPLAY ====================
+HostDisplay::HostDisplay()
+    : brightness(0),
+      headless(false) {
+    framebuffer.setColorDepth(16);
+    framebuffer.createSprite(WIDTH, HEIGHT);
+}
+
+void HostDisplay::capture(uint8_t* rgb) {
+    for (int16_t y = 0; y < HEIGHT; y++) {
+        for (int16_t x = 0; x < WIDTH; x++) {
+            // Expand RGB565 by bit replication so white stays 0xFFFFFF
+            uint16_t c = framebuffer.readPixel(x, y);
+            uint8_t r = (c >> 11) & 0x1F;
+            uint8_t g = (c >> 5) & 0x3F;
+            uint8_t b = c & 0x1F;
+            *rgb++ = (r << 3) | (r >> 2);
+            *rgb++ = (g << 2) | (g >> 4);
+            *rgb++ = (b << 3) | (b >> 2);
+        }
+    }
+}
+
+bool HostDisplay::writePpm(const char* path) {
+    uint8_t* rgb = (uint8_t*)malloc(FRAME_BYTES);
+    if (!rgb) return false;
+    capture(rgb);
+
+    bool ok = false;
+    FILE* file = fopen(path, "wb");
+    if (file) {
+        fprintf(file, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+        ok = fwrite(rgb, 1, FRAME_BYTES, file) == FRAME_BYTES;
+        ok = (fclose(file) == 0) && ok;
+    }
+    free(rgb);
+    return ok;
+}
+
+// ==================== FILESYSTEM ====================
+uint8_t* HostFileSystem::readFile(const char* path, size_t& length) {
+    char fullPath[256];
+    snprintf(fullPath, sizeof(fullPath), "%s%s", root, path);
+    FILE* file = fopen(fullPath, "rb");
+    if (!file) return nullptr;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = size > 0 ? (uint8_t*)malloc(size) : nullptr;
+    if (data && fread(data, 1, size, file) != (size_t)size) {
+        free(data);
+        data = nullptr;
+    }
+    fclose(file);
+    length = data ? (size_t)size : 0;
+    return data;
+}
+
+// ==================== STORAGE ====================
+bool HostStorage::load(const char* key, void* data, size_t length) {
+    std::map<std::string, std::vector<uint8_t>>::const_iterator it = records.find(key);
+    if (it == records.end() || it->second.size() != length) return false;
+    memcpy(data, it->second.data(), length);
+    return true;
+}
+
+bool HostStorage::save(const char* key, const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    records[key].assign(bytes, bytes + length);
+    writeCount++;
+    return true;
+}
+
+bool HostStorage::corrupt(const char* key, size_t offset) {
+    std::map<std::string, std::vector<uint8_t>>::iterator it = records.find(key);
+    if (it == records.end() || offset >= it->second.size()) return false;
+    it->second[offset] ^= 0xFF;
+    return true;
+}
+
+// ==================== FLASH ====================
+bool HostFlash::read(uint32_t offset, void* data, size_t length) {
+    if (offset + length > bytes.size()) return false;
+    memcpy(data, &bytes[offset], length);
+    return true;
+}
+
+bool HostFlash::write(uint32_t offset, const void* data, size_t length) {
+    if (offset + length > bytes.size()) return false;
+    if (failCount > 0) {
+        failCount--;
+        return false;
+    }
+    if (tearPending) {
+        tearPending = false;
+        length = min(length, tearAt);
+    }
+    const uint8_t* src = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        bytes[offset + i] &= src[i];
+    }
+    writeCount++;
+    return true;
+}
+
+bool HostFlash::loadFile(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bool ok = size > 0 && size % FLASH_SECTOR_SIZE == 0;
+    if (ok) {
+        bytes.resize((size_t)size);
+        ok = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    }
+    fclose(file);
+    return ok;
+}
+
+bool HostFlash::saveFile(const char* path) const {
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool HostFlash::eraseSector(uint32_t offset) {
+    if (offset % FLASH_SECTOR_SIZE != 0 || offset + FLASH_SECTOR_SIZE > bytes.size()) return false;
+    memset(&bytes[offset], 0xFF, FLASH_SECTOR_SIZE);
+    eraseCount++;
+    return true;
+}
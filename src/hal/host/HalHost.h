@@ -0,0 +1,199 @@
+/**
+ * Host HAL Implementation
+ * Virtual clock, scripted input, recorded speaker output and an in-memory
+ * 240x240 panel, so the firmware logic runs headless on Linux
+ */
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include "hal/Hal.h"
+#include "SpscQueue.h"
+
+// Virtual time: only advances when the driver says so
+class HostClock : public HalClock {
+public:
+    HostClock() : nowUs(0), wallBase(0) {}
+    uint32_t millis() override { return (uint32_t)(nowUs / 1000ULL); }
+    uint64_t micros() override { return nowUs; }
+    uint32_t wallSeconds() override { return wallBase ? wallBase + (uint32_t)(nowUs / 1000000ULL) : 0; }
+    void advanceUs(uint64_t us) { nowUs += us; }
+    void advanceMs(uint32_t ms) { nowUs += (uint64_t)ms * 1000ULL; }
+
+    // Wall clock reading at virtual time 0 (0 = no wall clock)
+    void setWallBase(uint32_t seconds) { wallBase = seconds; }
+
+private:
+    uint64_t nowUs;
+    uint32_t wallBase;
+};
+
+// One call to the speaker, stamped with the virtual clock (frequency 0 = stop)
+struct SpeakerEvent {
+    uint32_t atMs;
+    uint16_t frequency;
+    uint32_t durationMs;
+};
+
+// Records tones instead of playing them
+class HostSpeaker : public HalSpeaker {
+public:
+    explicit HostSpeaker(HostClock& clock) : clock(clock), playingUntilMs(0), toneCount(0) {}
+    void tone(uint16_t frequency, uint32_t durationMs) override;
+    void stop() override;
+    bool isPlaying() override { return clock.millis() < playingUntilMs; }
+    uint32_t getToneCount() const { return toneCount; }
+
+    // Every tone() and stop() since the last clearEvents()
+    const std::vector<SpeakerEvent>& getEvents() const { return events; }
+    void clearEvents() { events.clear(); }
+
+private:
+    HostClock& clock;
+    uint32_t playingUntilMs;
+    uint32_t toneCount;
+    std::vector<SpeakerEvent> events;
+};
+
+// Input driven by the host program
+class HostInput : public HalInput {
+public:
+    HostInput();
+    void update() override {}
+    bool isButtonPressed() override { return buttonDown; }
+    bool popEncoderStep(int8_t& step) override;
+    bool getTouchPress(int16_t& x, int16_t& y) override;
+    uint32_t getDroppedSteps() override { return steps.getDropped(); }
+
+    // Scripting
+    void setButton(bool down) { buttonDown = down; }
+    void pushEncoderStep(int8_t step);
+    void touch(int16_t x, int16_t y);
+
+private:
+    SpscQueue<int8_t, 64> steps;    // Same ring as the device's EncoderCapture
+    bool buttonDown;
+    bool touchPending;
+    int16_t touchX, touchY;
+};
+
+// In-memory RGB565 panel
+class HostDisplay : public HalDisplay {
+public:
+    static const int16_t WIDTH = 240;
+    static const int16_t HEIGHT = 240;
+    static const size_t FRAME_BYTES = (size_t)WIDTH * HEIGHT * 3; // RGB888 capture
+
+    HostDisplay();
+    LovyanGFX& panel() override { return framebuffer; }
+    void setBrightness(uint8_t level) override { brightness = level; }
+    uint8_t getBrightness() const { return brightness; }
+    bool isHeadless() override { return headless; }
+    void setHeadless(bool on) { headless = on; }            // Before PomodoroApp::begin()
+
+    // Frame capture: copy the panel out as RGB888 (FRAME_BYTES, row-major)
+    void capture(uint8_t* rgb);
+    // Write the panel as a binary PPM (P6); false on I/O error
+    bool writePpm(const char* path);
+
+private:
+    LGFX_Sprite framebuffer;
+    uint8_t brightness;
+    bool headless;
+};
+
+// Assets are read from a directory on the host (default: ./data)
+class HostFileSystem : public HalFileSystem {
+public:
+    HostFileSystem() : root("data") {}
+    void setRoot(const char* dir) { root = dir; }
+    uint8_t* readFile(const char* path, size_t& length) override;
+
+private:
+    const char* root;
+};
+
+// Fake NVS: records live in memory (survive an app "reboot", not the process)
+class HostStorage : public HalStorage {
+public:
+    HostStorage() : writeCount(0) {}
+    bool load(const char* key, void* data, size_t length) override;
+    bool save(const char* key, const void* data, size_t length) override;
+
+    // Testing
+    uint32_t getWriteCount() const { return writeCount; }
+    void erase() { records.clear(); }
+    bool corrupt(const char* key, size_t offset);   // Flip one byte of a stored record
+
+private:
+    std::map<std::string, std::vector<uint8_t>> records;
+    uint32_t writeCount;
+};
+
+// RTC memory stand-in: survives an app "reboot" until scrambled
+class HostRetainedMemory : public HalRetainedMemory {
+public:
+    static const size_t SIZE = 64;
+    HostRetainedMemory() { scramble(); }
+    void* data() override { return bytes; }
+    size_t size() override { return SIZE; }
+
+    // Testing: what a power-on reset leaves behind
+    void scramble() { for (size_t i = 0; i < SIZE; i++) bytes[i] = (uint8_t)(i * 151 + 7); }
+
+private:
+    uint8_t bytes[SIZE];
+};
+
+// Flash partition in memory, with NOR rules (erase to 0xFF, writes clear bits)
+class HostFlash : public HalFlash {
+public:
+    explicit HostFlash(uint32_t size)
+        : bytes(size, 0xFF), writeCount(0), eraseCount(0), tearAt(0), tearPending(false), failCount(0) {}
+    uint32_t size() override { return (uint32_t)bytes.size(); }
+    bool read(uint32_t offset, void* data, size_t length) override;
+    bool write(uint32_t offset, const void* data, size_t length) override;
+    bool eraseSector(uint32_t offset) override;
+
+    // Testing
+    uint32_t getWriteCount() const { return writeCount; }
+    uint32_t getEraseCount() const { return eraseCount; }
+    void eraseAll() { std::fill(bytes.begin(), bytes.end(), 0xFF); }
+    // Power loss mid-write: only the first `length` bytes of the next write land
+    void tearNextWrite(size_t length) { tearAt = length; tearPending = true; }
+    // Failing part: the next `count` writes change nothing and return false
+    void failWrites(uint32_t count) { failCount = count; }
+    // Partition images (e.g. from esptool read_flash); the size must be whole sectors
+    bool loadFile(const char* path);
+    bool saveFile(const char* path) const;
+
+private:
+    std::vector<uint8_t> bytes;
+    uint32_t writeCount;
+    uint32_t eraseCount;
+    size_t tearAt;
+    bool tearPending;
+    uint32_t failCount;
+};
+
+// Host platform singletons (install once, then drive them from the host program)
+struct HostPlatform {
+    HostClock clock;
+    HostSpeaker speaker;
+    HostInput input;
+    HostDisplay display;
+    HostFileSystem fs;
+    HostStorage storage;
+    HostRetainedMemory retained;
+    HostFlash journal;
+    HostFlash history;
+    HostPlatform() : speaker(clock), journal(4 * FLASH_SECTOR_SIZE), history(64 * FLASH_SECTOR_SIZE) {}
+};
+
+HostPlatform& installHostHal();
+
+#endif // HAL_HOST_H
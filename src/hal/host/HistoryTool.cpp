@@ -0,0 +1,192 @@
+/**
+ * Session History Tools Implementation
+ */
+
+#include <chrono>
+#include <time.h>
+#include "HistoryTool.h"
+#include "SessionHistory.h"
+
+static const char* kindName(TimerState kind) {
+    switch (kind) {
+        case STATE_RUNNING:     return "work";
+        case STATE_SHORT_BREAK: return "short_break";
+        case STATE_LONG_BREAK:  return "long_break";
+        default:                return "?";
+    }
+}
+
+// ==================== READER ====================
+struct ReadTotals {
+    bool csv;
+    uint32_t count[3];
+    uint64_t seconds[3];
+};
+
+static void printEntry(const HistoryEntry& entry, void* context) {
+    ReadTotals& totals = *(ReadTotals*)context;
+    uint8_t k = entry.kind == STATE_RUNNING ? 0 : entry.kind == STATE_SHORT_BREAK ? 1 : 2;
+    totals.count[k]++;
+    totals.seconds[k] += entry.duration;
+
+    char when[32];
+    if (entry.wallClock) {
+        time_t t = entry.endTime;
+        strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", gmtime(&t));
+    } else {
+        snprintf(when, sizeof(when), "boot+%lus", (unsigned long)entry.endTime);
+    }
+    if (totals.csv) {
+        printf("%s,%lu,%s,%lu\n", when, (unsigned long)entry.endTime, kindName(entry.kind),
+               (unsigned long)entry.duration);
+    } else {
+        printf("%-20s %-12s %3lu:%02lu\n", when, kindName(entry.kind),
+               (unsigned long)(entry.duration / 60), (unsigned long)(entry.duration % 60));
+    }
+}
+
+int readHistory(const char* path, bool csv) {
+    HostFlash flash(0);
+    if (!flash.loadFile(path)) {
+        fprintf(stderr, "history: cannot read %s (must be whole 4 KB sectors)\n", path);
+        return 1;
+    }
+    ReadTotals totals = { csv, { 0, 0, 0 }, { 0, 0, 0 } };
+    if (csv) printf("end,end_seconds,kind,duration_s\n");
+    uint32_t entries = SessionHistory::read(flash, printEntry, &totals);
+    if (csv) return 0;
+
+    uint32_t minErases, maxErases;
+    SessionHistory::readWear(flash, minErases, maxErases);
+    printf("%lu sessions: %lu work (%lu min), %lu short breaks, %lu long breaks\n",
+           (unsigned long)entries, (unsigned long)totals.count[0],
+           (unsigned long)(totals.seconds[0] / 60), (unsigned long)totals.count[1],
+           (unsigned long)totals.count[2]);
+    printf("Sector erases: %lu to %lu\n", (unsigned long)minErases, (unsigned long)maxErases);
+    return 0;
+}
+
+// ==================== INGEST BENCHMARK ====================
+struct ReadCheck {
+    uint32_t count;
+    uint32_t lastEnd;
+    uint32_t outOfOrder;
+};
+
+static void checkEntry(const HistoryEntry& entry, void* context) {
+    ReadCheck& check = *(ReadCheck*)context;
+    if (check.count > 0 && entry.endTime < check.lastEnd) check.outOfOrder++;
+    check.lastEnd = entry.endTime;
+    check.count++;
+}
+
+int runHistoryBenchmark(HostPlatform& platform, uint32_t years, const char* imagePath) {
+    // A workday: two cycles of four pomodoros with default settings, from 9:00,
+    // five days a week
+    static const uint32_t WORK_S = 25 * 60;
+    static const uint32_t SHORT_S = 5 * 60;
+    static const uint32_t LONG_S = 25 * 60;
+    static const uint32_t DAY_S = 24UL * 60UL * 60UL;
+    static const uint32_t EPOCH_MONDAY = 1704067200;   // 2024-01-01 00:00 UTC
+
+    platform.history.eraseAll();
+    platform.clock.setWallBase(EPOCH_MONDAY - (uint32_t)(platform.clock.micros() / 1000000ULL));
+
+    std::chrono::steady_clock::duration appendTime(0);
+    std::chrono::steady_clock::duration bootTime(0);
+    uint32_t appends = 0;
+    uint32_t failures = 0;
+    uint32_t lastEnd = 0;
+    uint32_t bytes = 0;
+    uint32_t erases = 0;
+    uint32_t days = years * 365;
+
+    for (uint32_t day = 0; day < days; day++) {
+        // Power on each morning: find the end of the log again
+        SessionHistory history;
+        std::chrono::steady_clock::time_point bootStart = std::chrono::steady_clock::now();
+        history.begin();
+        bootTime += std::chrono::steady_clock::now() - bootStart;
+
+        uint32_t dayStart = EPOCH_MONDAY + day * DAY_S;
+        if (day % 7 < 5) {
+            uint32_t now = dayStart + 9 * 3600;
+            for (uint8_t n = 0; n < 8; n++) {
+                TimerState kinds[2] = { STATE_RUNNING, (n % 4 == 3) ? STATE_LONG_BREAK : STATE_SHORT_BREAK };
+                for (uint8_t i = 0; i < 2; i++) {
+                    uint32_t duration = i == 0 ? WORK_S : (kinds[1] == STATE_LONG_BREAK ? LONG_S : SHORT_S);
+                    now += duration;
+                    platform.clock.advanceUs((uint64_t)(now - platform.clock.wallSeconds()) * 1000000ULL);
+                    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    if (!history.append(kinds[i], duration)) failures++;
+                    appendTime += std::chrono::steady_clock::now() - start;
+                    appends++;
+                    lastEnd = now;
+                }
+            }
+        }
+        bytes += history.getBytesWritten();
+        erases += history.getSectorErases();
+        platform.clock.advanceUs((uint64_t)(dayStart + DAY_S - platform.clock.wallSeconds()) * 1000000ULL);
+    }
+
+    // Read everything back, as a boot-time rebuild would
+    ReadCheck check = { 0, 0, 0 };
+    std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+    SessionHistory::read(platform.history, checkEntry, &check);
+    double readMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - readStart).count();
+
+    uint32_t minErases, maxErases;
+    SessionHistory::readWear(platform.history, minErases, maxErases);
+    double perDay = 16.0 * 5.0 / 7.0;
+    double retainedYears = check.count / perDay / 365.0;
+    double appendNs = std::chrono::duration<double, std::nano>(appendTime).count() / (appends ? appends : 1);
+    double bootUs = std::chrono::duration<double, std::micro>(bootTime).count() / (days ? days : 1);
+
+    printf("Ingested %lu sessions over %lu years (%.1f per day)\n",
+           (unsigned long)appends, (unsigned long)years, perDay);
+    printf("Append: %.0f ns avg, %.2f bytes per session incl. sector headers\n",
+           appendNs, appends ? (double)bytes / appends : 0.0);
+    printf("Boot scan: %.1f us avg\n", bootUs);
+    printf("Partition: %lu KB, retains %lu sessions = %.1f years at this rate\n",
+           (unsigned long)(platform.history.size() / 1024), (unsigned long)check.count, retainedYears);
+    printf("Sector erases: %lu total, %lu to %lu per sector\n",
+           (unsigned long)erases, (unsigned long)minErases, (unsigned long)maxErases);
+    printf("Read back: %.2f ms for %lu sessions\n", readMs, (unsigned long)check.count);
+
+    int failed = 0;
+    if (failures > 0) { printf("FAIL %lu appends failed\n", (unsigned long)failures); failed++; }
+    if (check.outOfOrder > 0) { printf("FAIL %lu entries out of order\n", (unsigned long)check.outOfOrder); failed++; }
+    if (check.count == 0 || check.lastEnd != lastEnd) { printf("FAIL newest entry not read back\n"); failed++; }
+    if (check.count > appends) { printf("FAIL more entries than appended\n"); failed++; }
+    if (maxErases > minErases + 1) { printf("FAIL uneven wear\n"); failed++; }
+
+    // Power loss mid-append: the torn record is dropped, the next boot appends after it
+    {
+        SessionHistory history;
+        history.begin();
+        platform.clock.advanceUs(WORK_S * 1000000ULL);
+        platform.history.tearNextWrite(1);
+        history.append(STATE_RUNNING, WORK_S);
+    }
+    {
+        SessionHistory history;
+        history.begin();
+        platform.clock.advanceUs(WORK_S * 1000000ULL);
+        history.append(STATE_RUNNING, WORK_S);
+        lastEnd = platform.clock.wallSeconds();
+    }
+    uint32_t retained = check.count;
+    check = ReadCheck{ 0, 0, 0 };
+    SessionHistory::read(platform.history, checkEntry, &check);
+    if (check.lastEnd != lastEnd || check.outOfOrder > 0 || check.count > retained + 1) {
+        printf("FAIL append after a torn record not read back\n");
+        failed++;
+    }
+
+    if (imagePath && !platform.history.saveFile(imagePath)) { printf("FAIL cannot write %s\n", imagePath); failed++; }
+
+    platform.clock.setWallBase(0);
+    printf("Failures: %d\n", failed);
+    return failed;
+}
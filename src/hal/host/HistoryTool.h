@@ -0,0 +1,21 @@
+/**
+ * Session History Tools (env:native)
+ * - Reader: prints a history partition image (esptool.py read_flash
+ *   0x774000 0x40000 history.bin) as a log or CSV, with totals and wear
+ * - Ingest benchmark: appends years of synthetic workdays through the real
+ *   SessionHistory on the host flash, rebooting every day, and reports append
+ *   cost, bytes per session, retained years, erase spread and read-back time
+ */
+
+#ifndef HISTORY_TOOL_H
+#define HISTORY_TOOL_H
+
+#include "hal/host/HalHost.h"
+
+// Returns 0 on success, 1 if the image can't be read
+int readHistory(const char* path, bool csv);
+
+// Returns the number of failed checks; imagePath (optional) receives the final partition
+int runHistoryBenchmark(HostPlatform& platform, uint32_t years, const char* imagePath);
+
+#endif // HISTORY_TOOL_H
@@ -0,0 +1,181 @@
+/**
+ * Session Simulator Implementation
+ */
+
+#include <chrono>
+#include "Simulator.h"
+#include "App.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include "hal/host/AppDriver.h"
+
+// Virtual time the scripted user waits at Ready before starting the next cycle
+static const uint32_t THINK_TIME_MS = 60UL * 1000UL;
+
+// A session may overrun its duration by the completion alarm
+static const uint32_t COMPLETION_SLACK_MS = 5000;
+
+// Three-letter state codes keep the trace to one short line per event
+static const char* stateCode(TimerState state) {
+    switch (state) {
+        case STATE_IDLE:        return "RDY";
+        case STATE_RUNNING:     return "RUN";
+        case STATE_PAUSED:      return "PAU";
+        case STATE_SHORT_BREAK: return "SHB";
+        case STATE_LONG_BREAK:  return "LNB";
+        case STATE_SETTINGS:    return "SET";
+        case STATE_STATS:       return "STA";
+    }
+    return "???";
+}
+
+// ==================== SCRIPTED SETUP ====================
+// Ready -> gear -> "Pomodoros/Long" (row 3) -> edit -> value -> "Back" (row 6)
+static bool setLongBreakEvery(PomodoroApp& app, AppDriver& driver, uint8_t every) {
+    driver.tap(CENTER_X, SCREEN_HEIGHT - 20);
+    driver.turnDial(3);
+    driver.shortPress();
+    driver.turnDial((int8_t)every - (int8_t)app.getSettings().pomodorosUntilLongBreak);
+    driver.shortPress();
+    driver.turnDial(3);
+    driver.shortPress();
+    return app.getState() == STATE_IDLE && app.getSettings().pomodorosUntilLongBreak == every;
+}
+
+// ==================== EXPECTATIONS ====================
+// Where a finished session must go next; sessionsDone counts completed work sessions
+static TimerState expectedAfter(TimerState state, uint32_t sessionsDone,
+                                const PomodoroSettings& settings) {
+    switch (state) {
+        case STATE_RUNNING:
+            return (sessionsDone % settings.pomodorosUntilLongBreak == 0) ? STATE_LONG_BREAK
+                                                                          : STATE_SHORT_BREAK;
+        case STATE_SHORT_BREAK: return STATE_RUNNING;
+        case STATE_LONG_BREAK:  return STATE_IDLE;
+        default:                return STATE_RUNNING; // Ready: the scripted user pressed start
+    }
+}
+
+static uint32_t expectedDurationMs(TimerState state, const PomodoroSettings& settings) {
+    switch (state) {
+        case STATE_RUNNING:     return settings.workDuration * 1000UL;
+        case STATE_SHORT_BREAK: return settings.shortBreakDuration * 1000UL;
+        case STATE_LONG_BREAK:  return settings.longBreakDuration * 1000UL;
+        default:                return 0;
+    }
+}
+
+#if ENABLE_TRACE
+static void writeToFile(const uint8_t* data, size_t length, void* context) {
+    fwrite(data, 1, length, (FILE*)context);
+}
+#endif
+
+// ==================== SIMULATION ====================
+int runSimulation(HostPlatform& platform, const SimulationOptions& options) {
+    // Sequencing only: frames are still published and bound, but not rasterized
+    // (the render test covers the pixels)
+    platform.display.setHeadless(true);
+    PomodoroApp app;
+    AppDriver driver(app, platform);
+    app.begin();
+    driver.settle();
+
+    if (options.longBreakEvery > 0 && !setLongBreakEvery(app, driver, options.longBreakEvery)) {
+        printf("simulate: could not set Pomodoros/Long to %u through the settings menu\n",
+               options.longBreakEvery);
+        return 1;
+    }
+    const PomodoroSettings& settings = app.getSettings();
+
+    uint32_t startMs = platform.clock.millis();
+    uint64_t endMs = startMs + (uint64_t)options.hours * 3600000ULL;
+    uint32_t startSteps = driver.getSteps();
+    std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+#if ENABLE_PERFORMANCE_MONITOR
+    profiler.reset();
+#endif
+
+    TimerState state = app.getState();
+    uint32_t enteredMs = startMs;
+    uint32_t sessionsDone = 0;
+    uint32_t cycles = 0;
+    uint32_t events = 0;
+    int violations = 0;
+
+    while (platform.clock.millis() < endMs) {
+        uint32_t now = platform.clock.millis();
+        if (state == STATE_IDLE && now - enteredMs >= THINK_TIME_MS) {
+            if (options.trace) printf("%10.1f press\n", now / 1000.0);
+            driver.shortPress();
+        } else {
+            driver.step();
+        }
+
+        TimerState next = app.getState();
+        if (next == state) continue;
+        events++;
+
+        // The change happened on the step that started at `now`
+        uint32_t heldMs = now - enteredMs;
+        if (state == STATE_RUNNING) sessionsDone++;
+        if (state == STATE_LONG_BREAK) cycles++;
+        if (options.trace) {
+            printf("%10.1f %s>%s #%lu\n", now / 1000.0, stateCode(state), stateCode(next),
+                   (unsigned long)sessionsDone);
+        }
+
+        TimerState expected = expectedAfter(state, sessionsDone, settings);
+        if (next != expected) {
+            printf("%10.1f !! %s>%s, expected %s\n", now / 1000.0, stateCode(state),
+                   stateCode(next), stateCode(expected));
+            violations++;
+        }
+        uint32_t durationMs = expectedDurationMs(state, settings);
+        if (durationMs > 0 && (heldMs + 1000 < durationMs || heldMs > durationMs + COMPLETION_SLACK_MS)) {
+            printf("%10.1f !! %s lasted %lu ms, expected %lu\n", now / 1000.0, stateCode(state),
+                   (unsigned long)heldMs, (unsigned long)durationMs);
+            violations++;
+        }
+        if (app.getCompletedPomodoros() != (uint8_t)sessionsDone) {
+            printf("%10.1f !! counter shows %u, %lu sessions completed\n", now / 1000.0,
+                   app.getCompletedPomodoros(), (unsigned long)sessionsDone);
+            violations++;
+        }
+
+        state = next;
+        enteredMs = now;
+    }
+
+    double realSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+    double simSeconds = (platform.clock.millis() - startMs) / 1000.0;
+    uint32_t steps = driver.getSteps() - startSteps;
+    printf("Simulated %.0f s in %.3f s real: %.0f simulated s per real s\n",
+           simSeconds, realSeconds, realSeconds > 0 ? simSeconds / realSeconds : 0.0);
+    printf("Loop steps: %lu (%.1f per simulated s)  Redraws: %lu  Tones: %lu\n",
+           (unsigned long)steps, simSeconds > 0 ? steps / simSeconds : 0.0,
+           (unsigned long)app.getRedrawCount(), (unsigned long)platform.speaker.getToneCount());
+    printf("Events: %lu  Work sessions: %lu  Full cycles: %lu  Long break every: %u\n",
+           (unsigned long)events, (unsigned long)sessionsDone, (unsigned long)cycles,
+           settings.pomodorosUntilLongBreak);
+    printf("Violations: %d\n", violations);
+    platform.display.setHeadless(false);
+#if ENABLE_PERFORMANCE_MONITOR
+    // Host timings: real nanoseconds per phase over the whole run
+    Serial.setEnabled(true);
+    profiler.report((uint32_t)(realSeconds * 1000.0));
+    Serial.setEnabled(false);
+#endif
+#if ENABLE_TRACE
+    if (options.traceDumpPath) {
+        FILE* file = fopen(options.traceDumpPath, "wb");
+        if (file) {
+            tracer.dump(writeToFile, file);
+            fclose(file);
+        } else {
+            printf("simulate: cannot write %s\n", options.traceDumpPath);
+        }
+    }
+#endif
+    return violations;
+}
@@ -0,0 +1,25 @@
+/**
+ * Session Simulator (env:native)
+ * Runs the app for hours of virtual time with a scripted user who starts a
+ * new cycle whenever the timer is back at Ready, checks every state change
+ * against the work -> break -> ... -> long break -> Ready sequence and
+ * reports throughput in simulated seconds per real second. The display is
+ * headless: frames are bound but not rasterized.
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "hal/host/HalHost.h"
+
+struct SimulationOptions {
+    uint32_t hours;             // Virtual time to cover
+    uint8_t longBreakEvery;     // Set through the settings menu first (0 = keep default)
+    bool trace;                 // Print one line per event
+    const char* traceDumpPath;  // Write the binary event trace here at the end (nullptr: don't)
+};
+
+// Returns the number of sequencing violations (0 = every transition was expected)
+int runSimulation(HostPlatform& platform, const SimulationOptions& options);
+
+#endif // SIMULATOR_H
@@ -0,0 +1,173 @@
+/**
+ * Focus Statistics Benchmark Implementation
+ */
+
+#include <chrono>
+#include <time.h>
+#include <vector>
+#include "StatsBench.h"
+#include "FocusStats.h"
+#include "SessionHistory.h"
+
+static const uint32_t DAY_S = 24UL * 60UL * 60UL;
+static const uint32_t EPOCH_MONDAY = 1704067200;   // 2024-01-01 00:00 UTC
+
+// Deterministic workload, so runs are comparable
+static uint32_t nextRandom(uint32_t& seed) {
+    seed ^= seed << 13;     // xorshift32
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+// ==================== REFERENCE ====================
+// Everything recomputed from the full list with libc calendar functions
+static void rescan(const std::vector<HistoryEntry>& entries, uint32_t now, StatsSummary& summary) {
+    memset(&summary, 0, sizeof(summary));
+    summary.wallClock = true;
+    time_t t = now;
+    struct tm nowTm;
+    gmtime_r(&t, &nowTm);
+    uint32_t today = now / DAY_S;
+    uint32_t weekStart = today - (nowTm.tm_wday + 6) % 7;
+
+    std::vector<bool> active(today + 1, false);
+    uint32_t firstDay = today;
+    uint64_t focusSeconds = 0;
+    for (const HistoryEntry& entry : entries) {
+        if (entry.kind != STATE_RUNNING) continue;
+        summary.focusSessions++;
+        focusSeconds += entry.duration;
+        uint32_t day = entry.endTime / DAY_S;
+        time_t end = entry.endTime;
+        struct tm endTm;
+        gmtime_r(&end, &endTm);
+        if (day == today) summary.todaySeconds += entry.duration;
+        if (day >= weekStart && day <= today) summary.weekSeconds += entry.duration;
+        if (endTm.tm_year == nowTm.tm_year && endTm.tm_mon == nowTm.tm_mon) summary.monthSeconds += entry.duration;
+        active[day] = true;
+        if (day < firstDay) firstDay = day;
+    }
+    summary.averageSeconds = summary.focusSessions ? (uint32_t)(focusSeconds / summary.focusSessions) : 0;
+
+    uint16_t run = 0;
+    for (uint32_t day = firstDay; day <= today; day++) {
+        run = active[day] ? run + 1 : 0;
+        if (run > summary.bestStreakDays) summary.bestStreakDays = run;
+    }
+    // A streak is still alive if it ended yesterday
+    uint32_t day = active[today] ? today : today - 1;
+    while (day >= firstDay && active[day]) {
+        summary.streakDays++;
+        day--;
+    }
+}
+
+static bool sameSummary(const StatsSummary& a, const StatsSummary& b) {
+    return a.wallClock == b.wallClock && a.todaySeconds == b.todaySeconds &&
+           a.weekSeconds == b.weekSeconds && a.monthSeconds == b.monthSeconds &&
+           a.streakDays == b.streakDays && a.bestStreakDays == b.bestStreakDays &&
+           a.focusSessions == b.focusSessions && a.averageSeconds == b.averageSeconds;
+}
+
+static void printSummary(const char* label, const StatsSummary& s) {
+    printf("  %-9s today %lu min, week %lu min, month %lu min, streak %u (best %u), %lu sessions, avg %lu s\n",
+           label, (unsigned long)(s.todaySeconds / 60), (unsigned long)(s.weekSeconds / 60),
+           (unsigned long)(s.monthSeconds / 60), s.streakDays, s.bestStreakDays,
+           (unsigned long)s.focusSessions, (unsigned long)s.averageSeconds);
+}
+
+// ==================== BENCHMARK ====================
+int runStatsBenchmark(HostPlatform& platform, uint32_t days) {
+    platform.history.eraseAll();
+    platform.clock.setWallBase(EPOCH_MONDAY - (uint32_t)(platform.clock.micros() / 1000000ULL));
+
+    SessionHistory history;
+    history.begin();
+    FocusStats stats;
+    std::vector<HistoryEntry> entries;
+    uint32_t seed = 12345;
+    int failed = 0;
+    uint32_t mismatchedDays = 0;
+
+    for (uint32_t day = 0; day < days; day++) {
+        uint32_t dayStart = EPOCH_MONDAY + day * DAY_S;
+
+        // Most days have some focus time; a few are skipped to break streaks
+        if (nextRandom(seed) % 100 < 80) {
+            uint32_t now = dayStart + 8 * 3600 + nextRandom(seed) % (3 * 3600);
+            uint8_t sessions = 1 + nextRandom(seed) % 10;
+            for (uint8_t n = 0; n < sessions; n++) {
+                uint32_t work = (nextRandom(seed) % 5 == 0 ? 50 : 25) * 60;
+                uint32_t rest = (n % 4 == 3 ? 15 : 5) * 60;
+                TimerState kinds[2] = { STATE_RUNNING, n % 4 == 3 ? STATE_LONG_BREAK : STATE_SHORT_BREAK };
+                uint32_t durations[2] = { work, rest };
+                for (uint8_t i = 0; i < 2; i++) {
+                    now += durations[i];
+                    platform.clock.advanceUs((uint64_t)(now - platform.clock.wallSeconds()) * 1000000ULL);
+                    // Same path as PomodoroApp::onSessionComplete
+                    HistoryEntry entry = SessionHistory::stamp(kinds[i], durations[i]);
+                    history.append(entry);
+                    stats.record(entry);
+                    entries.push_back(entry);
+                }
+            }
+        }
+
+        // Late evening: what the statistics screen would show
+        uint32_t evening = dayStart + 23 * 3600;
+        StatsSummary incremental, reference;
+        stats.summarize(evening, incremental);
+        rescan(entries, evening, reference);
+        if (!sameSummary(incremental, reference)) {
+            if (mismatchedDays++ == 0) {
+                printf("FAIL day %lu differs from a full rescan\n", (unsigned long)day);
+                printSummary("running", incremental);
+                printSummary("rescan", reference);
+            }
+        }
+        platform.clock.advanceUs((uint64_t)(dayStart + DAY_S - platform.clock.wallSeconds()) * 1000000ULL);
+    }
+    if (mismatchedDays > 0) failed++;
+
+    // Update cost: replay the events into a fresh engine, many times over
+    static const uint32_t PASSES = 20;
+    FocusStats timed;
+    std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < PASSES; pass++) {
+        timed.clear();
+        for (const HistoryEntry& entry : entries) timed.record(entry);
+    }
+    double updateNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - updateStart).count() /
+                      (entries.empty() ? 1 : entries.size() * PASSES);
+
+    // Boot: rebuild from the log alone and compare with the running aggregates
+    uint32_t now = platform.clock.wallSeconds();
+    FocusStats rebuilt;
+    std::chrono::steady_clock::time_point rebuildStart = std::chrono::steady_clock::now();
+    uint32_t replayed = rebuilt.rebuild(history);
+    double rebuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStart).count();
+    StatsSummary running, fromLog;
+    stats.summarize(now, running);
+    rebuilt.summarize(now, fromLog);
+
+    printf("Fed %lu sessions over %lu days (%lu work)\n",
+           (unsigned long)entries.size(), (unsigned long)days, (unsigned long)running.focusSessions);
+    printf("Update: %.1f ns per event, %u bytes of state\n", updateNs, (unsigned)sizeof(FocusStats));
+    printf("Rebuild: %.2f ms for %lu logged sessions (%.0f ns each)\n",
+           rebuildMs, (unsigned long)replayed, replayed ? rebuildMs * 1e6 / replayed : 0.0);
+    printSummary("final", running);
+    printf("Days checked against a full rescan: %lu, mismatched: %lu\n",
+           (unsigned long)days, (unsigned long)mismatchedDays);
+
+    if (replayed != entries.size()) { printf("FAIL log returned %lu of %lu sessions\n", (unsigned long)replayed, (unsigned long)entries.size()); failed++; }
+    if (!sameSummary(running, fromLog)) {
+        printf("FAIL rebuild differs from the running aggregates\n");
+        printSummary("rebuilt", fromLog);
+        failed++;
+    }
+
+    platform.clock.setWallBase(0);
+    printf("Failures: %d\n", failed);
+    return failed;
+}
@@ -0,0 +1,17 @@
+/**
+ * Focus Statistics Benchmark (env:native)
+ * Feeds days of synthetic sessions through the same path as the app (history
+ * log append, then FocusStats::record), checks the running aggregates against
+ * a full rescan at the end of every day, and reports the per-event update
+ * cost and the boot-time rebuild from the log.
+ */
+
+#ifndef STATS_BENCH_H
+#define STATS_BENCH_H
+
+#include "hal/host/HalHost.h"
+
+// Returns the number of failed checks
+int runStatsBenchmark(HostPlatform& platform, uint32_t days);
+
+#endif // STATS_BENCH_H
@@ -0,0 +1,87 @@
+/**
+ * Trace Decoder Implementation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "TraceDecoder.h"
+#include "Trace.h"
+
+// Find the dump header in a capture that may start with ordinary Serial output
+static const uint8_t* findDump(const uint8_t* data, size_t length, TraceDumpHeader& header) {
+    for (size_t i = 0; i + sizeof(TraceDumpHeader) <= length; i++) {
+        if (memcmp(data + i, "PTRC", 4) != 0) continue;
+        memcpy(&header, data + i, sizeof(header));
+        size_t recordsBytes = (size_t)header.count * sizeof(TraceRecord);
+        if (header.version == TRACE_DUMP_VERSION && header.recordSize == sizeof(TraceRecord) &&
+            i + sizeof(header) + recordsBytes <= length) {
+            return data + i + sizeof(header);
+        }
+    }
+    return nullptr;
+}
+
+static void printArgsJson(const TraceEventInfo& info, const TraceRecord& r) {
+    printf("\"args\":{");
+    if (info.arg0) printf("\"%s\":%u", info.arg0, r.arg0);
+    if (info.arg1) printf("%s\"%s\":%lu", info.arg0 ? "," : "", info.arg1, (unsigned long)r.arg1);
+    printf("}");
+}
+
+int decodeTrace(const char* path, bool chromeJson) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "decode: cannot open %s\n", path);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = size > 0 ? (uint8_t*)malloc(size) : nullptr;
+    size_t length = data ? fread(data, 1, size, file) : 0;
+    fclose(file);
+
+    TraceDumpHeader header;
+    const uint8_t* payload = data ? findDump(data, length, header) : nullptr;
+    if (!payload) {
+        fprintf(stderr, "decode: no trace dump (version %u) in %s\n", TRACE_DUMP_VERSION, path);
+        free(data);
+        return 1;
+    }
+
+    if (chromeJson) printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    else printf("# %lu records (%lu older records overwritten)\n",
+                (unsigned long)header.count, (unsigned long)header.overwritten);
+
+    // Timestamps are 32-bit micros(): unwrap so the trace stays monotonic
+    uint64_t timeUs = 0;
+    uint32_t lastStamp = 0;
+    for (uint32_t i = 0; i < header.count; i++) {
+        TraceRecord r;
+        memcpy(&r, payload + (size_t)i * sizeof(TraceRecord), sizeof(r));
+        if (i > 0) timeUs += (uint32_t)(r.timestampUs - lastStamp);
+        else timeUs = r.timestampUs;
+        lastStamp = r.timestampUs;
+
+        const TraceEventInfo& info = getTraceEventInfo(r.event);
+        if (chromeJson) {
+            const char* phase = r.event == TRACE_REDRAW_BEGIN ? "B" :
+                                r.event == TRACE_REDRAW_END ? "E" : "i";
+            printf("%s{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%llu,\"pid\":1,\"tid\":1,%s",
+                   i > 0 ? ",\n" : "", info.name, phase, (unsigned long long)timeUs,
+                   phase[0] == 'i' ? "\"s\":\"g\"," : "");
+            printArgsJson(info, r);
+            printf("}");
+        } else {
+            printf("[%12.6f] %s", timeUs / 1e6, info.name);
+            if (info.arg0) printf(" %s=%u", info.arg0, r.arg0);
+            if (info.arg1) printf(" %s=%lu", info.arg1, (unsigned long)r.arg1);
+            printf("\n");
+        }
+    }
+    if (chromeJson) printf("\n]}\n");
+
+    free(data);
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ * Trace Decoder (env:native)
+ * Turns a binary trace dump (see Trace.h) into a readable log or Chrome
+ * trace JSON (load in chrome://tracing or Perfetto). The dump may be a raw
+ * serial capture: text before the "PTRC" header is skipped.
+ */
+
+#ifndef TRACE_DECODER_H
+#define TRACE_DECODER_H
+
+// Returns 0 on success, 1 if no valid dump was found
+int decodeTrace(const char* path, bool chromeJson);
+
+#endif // TRACE_DECODER_H
@@ -0,0 +1,196 @@
+/**
+ * Fixed-Point Trig Benchmark Implementation
+ */
+
+#include "TrigBench.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include "FixedTrig.h"
+#include "config.h"
+
+static const int16_t RING_OUTER = CIRCLE_RADIUS + CIRCLE_THICKNESS / 2;
+static const int16_t RING_INNER = CIRCLE_RADIUS - CIRCLE_THICKNESS / 2;
+static const uint32_t MAX_RING_PIXELS = 8192;
+static const int ROUNDS = 200;
+
+// Keeps the timed loops from being optimized away
+static volatile int32_t sink;
+
+static double elapsedNs(std::chrono::steady_clock::time_point start, uint32_t operations) {
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / operations;
+}
+
+// ==================== TABLE ====================
+static int checkTable() {
+    int32_t maxError = 0;
+    for (uint16_t i = 0; i < TRIG_STEPS; i++) {
+        double exact = sin(2.0 * M_PI * i / TRIG_STEPS) * Q15_ONE;
+        int32_t expected = (int32_t)lround(exact > 32767 ? 32767 : exact);
+        int32_t error = abs(SINE_TABLE.values[i] - expected);
+        if (error > maxError) maxError = error;
+    }
+    printf("Table: %u entries, %u bytes, max error %ld Q15 steps\n",
+           TRIG_STEPS, (unsigned)sizeof(SINE_TABLE), (long)maxError);
+    if (maxError > 1) {
+        printf("FAIL sine table is off by %ld Q15 steps\n", (long)maxError);
+        return 1;
+    }
+    return 0;
+}
+
+// ==================== POLAR ====================
+static int checkPolar() {
+    uint32_t points = (uint32_t)(RING_OUTER - RING_INNER + 1) * TRIG_STEPS;
+    int32_t acc = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int16_t r = RING_INNER; r <= RING_OUTER; r++) {
+            for (uint16_t a = 0; a < TRIG_STEPS; a++) {
+                int16_t x, y;
+                polarToScreen(CENTER_X, CENTER_Y, r, a, x, y);
+                acc += x ^ y;
+            }
+        }
+    }
+    double tableNs = elapsedNs(start, points * ROUNDS);
+
+    const float radiansPerStep = 2.0f * (float)M_PI / TRIG_STEPS;
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int16_t r = RING_INNER; r <= RING_OUTER; r++) {
+            for (uint16_t a = 0; a < TRIG_STEPS; a++) {
+                float angle = a * radiansPerStep;
+                int16_t x = CENTER_X + (int16_t)lroundf(r * sinf(angle));
+                int16_t y = CENTER_Y - (int16_t)lroundf(r * cosf(angle));
+                acc += x ^ y;
+            }
+        }
+    }
+    double libmNs = elapsedNs(start, points * ROUNDS);
+    sink = acc;
+
+    // Agreement with libm, point by point
+    int16_t maxError = 0;
+    uint32_t differing = 0;
+    for (int16_t r = RING_INNER; r <= RING_OUTER; r++) {
+        for (uint16_t a = 0; a < TRIG_STEPS; a++) {
+            int16_t x, y;
+            polarToScreen(CENTER_X, CENTER_Y, r, a, x, y);
+            double angle = 2.0 * M_PI * a / TRIG_STEPS;
+            int16_t ex = CENTER_X + (int16_t)lround(r * sin(angle));
+            int16_t ey = CENTER_Y - (int16_t)lround(r * cos(angle));
+            int16_t error = (int16_t)std::max(abs(x - ex), abs(y - ey));
+            if (error) differing++;
+            if (error > maxError) maxError = error;
+        }
+    }
+    printf("Polar: %lu points (r %d..%d), table %.2f ns, libm %.2f ns per point; "
+           "%lu differ from libm, by at most %d px\n",
+           (unsigned long)points, RING_INNER, RING_OUTER, tableNs, libmNs,
+           (unsigned long)differing, maxError);
+    if (maxError > 1) {
+        printf("FAIL polar points are off by %d px\n", maxError);
+        return 1;
+    }
+    return 0;
+}
+
+// ==================== ANGLE ====================
+static int16_t libmStep(int16_t dx, int16_t dy) {
+    float degrees = atan2f((float)dx, (float)-dy) * (180.0f / (float)M_PI);
+    float along = degrees + PROGRESS_ARC_SWEEP_DEG / 2.0f;
+    if (along < 0 || along >= PROGRESS_ARC_SWEEP_DEG) return -1;
+    return (int16_t)(along * PROGRESS_ARC_STEPS / PROGRESS_ARC_SWEEP_DEG);
+}
+
+static int16_t tableStep(int16_t dx, int16_t dy) {
+    const int64_t turn = 360LL * FINE_ANGLE_TURN;
+    const int64_t sweep = (int64_t)PROGRESS_ARC_SWEEP_DEG * FINE_ANGLE_TURN;
+    int64_t along = ((int64_t)screenAngle(dx, dy) * 360 + sweep / 2) % turn;
+    if (along >= sweep) return -1;
+    return (int16_t)(along * PROGRESS_ARC_STEPS / sweep);
+}
+
+static bool onRing(int16_t dx, int16_t dy) {
+    int32_t r2 = (int32_t)dx * dx + (int32_t)dy * dy;
+    return r2 >= (int32_t)(RING_INNER - 1) * (RING_INNER - 1) &&
+           r2 <= (int32_t)(RING_OUTER + 1) * (RING_OUTER + 1);
+}
+
+static int checkAngle() {
+    // The pixels ProgressArc::build classifies
+    static int16_t ringX[MAX_RING_PIXELS];
+    static int16_t ringY[MAX_RING_PIXELS];
+    uint32_t count = 0;
+    for (int16_t dy = -RING_OUTER - 1; dy <= RING_OUTER + 1; dy++) {
+        for (int16_t dx = -RING_OUTER - 1; dx <= RING_OUTER + 1; dx++) {
+            if (onRing(dx, dy) && count < MAX_RING_PIXELS) {
+                ringX[count] = dx;
+                ringY[count] = dy;
+                count++;
+            }
+        }
+    }
+
+    int32_t acc = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (uint32_t i = 0; i < count; i++) acc += screenAngle(ringX[i], ringY[i]);
+    }
+    double tableNs = elapsedNs(start, count * ROUNDS);
+
+    start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (uint32_t i = 0; i < count; i++) acc += (int32_t)(atan2f(ringX[i], -ringY[i]) * 10430.378f);
+    }
+    double libmNs = elapsedNs(start, count * ROUNDS);
+    sink = acc;
+
+    // Angle error in fine units, and arc steps that land differently
+    int32_t maxError = 0;
+    uint32_t stepDiffs = 0, stepFar = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        double exact = atan2((double)ringX[i], (double)-ringY[i]) / (2.0 * M_PI) * FINE_ANGLE_TURN;
+        if (exact < 0) exact += FINE_ANGLE_TURN;
+        int32_t error = abs((int32_t)screenAngle(ringX[i], ringY[i]) - (int32_t)lround(exact));
+        if (error > (int32_t)FINE_ANGLE_TURN / 2) error = FINE_ANGLE_TURN - error;
+        if (error > maxError) maxError = error;
+
+        int16_t expected = libmStep(ringX[i], ringY[i]);
+        int16_t actual = tableStep(ringX[i], ringY[i]);
+        if (expected != actual) {
+            stepDiffs++;
+            if (expected < 0 || actual < 0 || abs(expected - actual) > 1) stepFar++;
+        }
+    }
+    printf("Angle: %lu ring pixels, table %.2f ns, libm atan2f %.2f ns per pixel; "
+           "max error %ld/65536 turn (%.4f deg)\n",
+           (unsigned long)count, tableNs, libmNs, (long)maxError, maxError * 360.0 / FINE_ANGLE_TURN);
+    printf("Arc steps: %lu pixels land in a neighbouring step, %lu further off\n",
+           (unsigned long)stepDiffs, (unsigned long)stepFar);
+
+    int failed = 0;
+    // Under a tenth of an arc step (1/1536 turn) of error
+    if (maxError * 10 > (int32_t)(FINE_ANGLE_TURN * PROGRESS_ARC_SWEEP_DEG / 360 / PROGRESS_ARC_STEPS)) {
+        printf("FAIL screenAngle is off by %ld/65536 turn\n", (long)maxError);
+        failed++;
+    }
+    if (stepFar) {
+        printf("FAIL %lu pixels changed arc step by more than one\n", (unsigned long)stepFar);
+        failed++;
+    }
+    return failed;
+}
+
+// ==================== BENCHMARK ====================
+int runTrigBenchmark(HostPlatform& platform) {
+    (void)platform;     // Pure table math: same signature as the other benches, no HAL needed
+    int failed = checkTable();
+    failed += checkPolar();
+    failed += checkAngle();
+    printf("Failures: %d\n", failed);
+    return failed;
+}
@@ -0,0 +1,20 @@
+/**
+ * Fixed-Point Trig Benchmark (env:native)
+ * Compares the compile-time Q15 table against libm on the ring drawn around
+ * the countdown (CIRCLE_RADIUS +/- CIRCLE_THICKNESS / 2):
+ * - Table: every entry against sin() to within one Q15 step
+ * - Polar: points at every table angle on every ring radius, ns per point
+ *   and the largest pixel disagreement with sinf/cosf
+ * - Angle: screenAngle against atan2f for every pixel of the ring, ns per
+ *   pixel, the largest angle error and the progress arc steps that differ
+ */
+
+#ifndef TRIG_BENCH_H
+#define TRIG_BENCH_H
+
+#include "hal/host/HalHost.h"
+
+// Returns the number of failed checks
+int runTrigBenchmark(HostPlatform& platform);
+
+#endif // TRIG_BENCH_H
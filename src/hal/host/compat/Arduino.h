@@ -0,0 +1,61 @@
+/**
+ * Host Arduino Compatibility
+ * The small slice of the Arduino API the shared modules use, for env:native.
+ * Time comes from the host HAL clock, so simulations control it.
+ */
+
+#ifndef HOST_ARDUINO_COMPAT_H
+#define HOST_ARDUINO_COMPAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
+#define IRAM_ATTR
+
+// Backed by hal.clock (see HalHost.cpp)
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+inline bool psramFound() { return false; }
+
+// Serial goes to stdout; quiet by default so simulations stay fast
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    void flush() { fflush(stdout); }
+    void setEnabled(bool on) { enabled = on; }
+
+    void print(const char* s) { if (enabled) fputs(s, stdout); }
+    void print(char c) { if (enabled) fputc(c, stdout); }
+    void print(int v) { if (enabled) printf("%d", v); }
+    void print(unsigned int v) { if (enabled) printf("%u", v); }
+    void print(long v) { if (enabled) printf("%ld", v); }
+    void print(unsigned long v) { if (enabled) printf("%lu", v); }
+    void print(long long v) { if (enabled) printf("%lld", v); }
+    void print(unsigned long long v) { if (enabled) printf("%llu", v); }
+    void print(double v, int digits = 2) { if (enabled) printf("%.*f", digits, v); }
+
+    void println() { print("\n"); }
+    template <typename T> void println(T v) { print(v); println(); }
+    void println(double v, int digits) { print(v, digits); println(); }
+
+private:
+    bool enabled = false;
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_COMPAT_H
@@ -0,0 +1,80 @@
+/**
+ * Host Entry Point (env:native)
+ *   program [simulate] [hours] [--long-every N] [--quiet] [--dump-trace file]
+ *       Run a day (or the given hours) of pomodoro cycles on a virtual clock,
+ *       tracing and checking every state change (see Simulator.h)
+ *   program arc
+ *       Benchmark the progress arc: pixels per frame against the swept angle,
+ *       and arc frame rates in real sessions (see ArcBench.h)
+ *   program trig
+ *       Benchmark the fixed-point trig table against libm on the ring
+ *       (see TrigBench.h)
+ *   program history <image> [--csv]
+ *   program history bench [years] [--image out]
+ *       Print a history partition image, or benchmark ingest (see HistoryTool.h)
+ *   program stats [days]
+ *       Benchmark the focus statistics over a year (or the given days) of
+ *       synthetic sessions: update cost and boot rebuild (see StatsBench.h)
+ *   program decode <dump> [--chrome]
+ *       Print a binary event trace as a log or Chrome trace JSON (see TraceDecoder.h)
+ * The behavioural checks (rendering, settings persistence, session resume)
+ * are Unity tests under test/: pio test -e native
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal/host/ArcBench.h"
+#include "hal/host/HalHost.h"
+#include "hal/host/HistoryTool.h"
+#include "hal/host/Simulator.h"
+#include "hal/host/StatsBench.h"
+#include "hal/host/TraceDecoder.h"
+#include "hal/host/TrigBench.h"
+
+// Test programs under test/ bring their own main()
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+    HostPlatform& platform = installHostHal();
+
+    if (argc > 1 && strcmp(argv[1], "arc") == 0) {
+        return runArcBenchmark(platform) == 0 ? 0 : 1;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "trig") == 0) {
+        return runTrigBenchmark(platform) == 0 ? 0 : 1;
+    }
+
+    if (argc > 2 && strcmp(argv[1], "history") == 0) {
+        if (strcmp(argv[2], "bench") != 0) {
+            return readHistory(argv[2], argc > 3 && strcmp(argv[3], "--csv") == 0);
+        }
+        uint32_t years = 20;
+        const char* imagePath = nullptr;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--image") == 0 && i + 1 < argc) imagePath = argv[++i];
+            else years = strtoul(argv[i], nullptr, 10);
+        }
+        return runHistoryBenchmark(platform, years, imagePath) == 0 ? 0 : 1;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "stats") == 0) {
+        uint32_t days = argc > 2 ? strtoul(argv[2], nullptr, 10) : 365;
+        return runStatsBenchmark(platform, days) == 0 ? 0 : 1;
+    }
+
+    if (argc > 2 && strcmp(argv[1], "decode") == 0) {
+        return decodeTrace(argv[2], argc > 3 && strcmp(argv[3], "--chrome") == 0);
+    }
+
+    SimulationOptions options = { 24, 0, true, nullptr };
+    int first = (argc > 1 && strcmp(argv[1], "simulate") == 0) ? 2 : 1;
+    for (int i = first; i < argc; i++) {
+        if (strcmp(argv[i], "--quiet") == 0) options.trace = false;
+        else if (strcmp(argv[i], "--long-every") == 0 && i + 1 < argc) options.longBreakEvery = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--dump-trace") == 0 && i + 1 < argc) options.traceDumpPath = argv[++i];
+        else options.hours = strtoul(argv[i], nullptr, 10);
+    }
+    return runSimulation(platform, options) == 0 ? 0 : 1;
+}
+#endif // PIO_UNIT_TESTING
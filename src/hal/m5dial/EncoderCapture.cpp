@@ -0,0 +1,85 @@
+/**
+ * Encoder Capture Implementation
+ * Full quadrature decoding (every valid A/B transition is one count)
+ */
+
+#include "EncoderCapture.h"
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+
+EncoderCapture* EncoderCapture::instance = nullptr;
+
+// Step for each (previous AB << 2 | current AB) transition; 0 = no move or invalid bounce
+static const int8_t QUADRATURE_TABLE[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+// Direct register read of both encoder pins (safe while the flash cache is disabled)
+static inline uint8_t IRAM_ATTR readAB() {
+    uint32_t in = REG_READ(GPIO_IN1_REG); // GPIO32..48
+    uint8_t a = (in >> (ENCODER_PIN_A - 32)) & 1;
+    uint8_t b = (in >> (ENCODER_PIN_B - 32)) & 1;
+    return (a << 1) | b;
+}
+
+EncoderCapture::EncoderCapture()
+    : queue(),
+      lastAB(0),
+      wakeTask(nullptr),
+      mux(portMUX_INITIALIZER_UNLOCKED) {
+}
+
+void EncoderCapture::begin(TaskHandle_t wakeTask) {
+    this->wakeTask = wakeTask;
+    instance = this;
+
+    pinMode(ENCODER_PIN_A, INPUT_PULLUP);
+    pinMode(ENCODER_PIN_B, INPUT_PULLUP);
+    lastAB = readAB();
+
+    attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_A), onEdge, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(ENCODER_PIN_B), onEdge, CHANGE);
+}
+
+bool EncoderCapture::pop(EncoderEvent& event) {
+    return queue.pop(event);
+}
+
+void IRAM_ATTR EncoderCapture::onEdge() {
+    if (instance) {
+        instance->handleEdge();
+    }
+}
+
+void EncoderCapture::sync() {
+    portENTER_CRITICAL(&mux);
+    decode();
+    portEXIT_CRITICAL(&mux);
+}
+
+void IRAM_ATTR EncoderCapture::handleEdge() {
+    portENTER_CRITICAL_ISR(&mux);
+    bool queued = decode();
+    portEXIT_CRITICAL_ISR(&mux);
+
+    if (queued && wakeTask) {
+        BaseType_t higherPriorityWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(wakeTask, &higherPriorityWoken);
+        if (higherPriorityWoken) {
+            portYIELD_FROM_ISR();
+        }
+    }
+}
+
+bool IRAM_ATTR EncoderCapture::decode() {
+    uint8_t ab = readAB();
+    int8_t step = QUADRATURE_TABLE[(lastAB << 2) | ab];
+    lastAB = ab;
+    if (step == 0) return false;
+
+    EncoderEvent event = { (uint32_t)esp_timer_get_time(), step };
+    return queue.push(event);
+}
@@ -0,0 +1,54 @@
+/**
+ * Encoder Capture Module
+ * Decodes the dial's quadrature signal in a GPIO interrupt and queues
+ * timestamped steps for InputHandler to drain
+ */
+
+#ifndef ENCODER_CAPTURE_H
+#define ENCODER_CAPTURE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SpscQueue.h"
+
+// One encoder count, in the same units M5Dial.Encoder.read() used
+struct EncoderEvent {
+    uint32_t timestampUs;
+    int8_t step;           // +1 clockwise, -1 counter-clockwise
+};
+
+class EncoderCapture {
+public:
+    // Constructor
+    EncoderCapture();
+
+    // Configure the pins and attach the interrupts; wakeTask (optional) is
+    // notified from the ISR so a sleeping loop picks the event up immediately
+    void begin(TaskHandle_t wakeTask);
+
+    // Consumer side: pop the oldest event, returns false if the queue is empty
+    bool pop(EncoderEvent& event);
+
+    // Decode any transition whose interrupt was missed (e.g. the edge that
+    // woke the chip from light sleep)
+    void sync();
+
+    // Events lost because the consumer fell more than QUEUE_SIZE steps behind
+    uint32_t getDropped() const { return queue.getDropped(); }
+
+private:
+    // ISR (producer) -> loop (consumer)
+    static const uint8_t QUEUE_SIZE = 64;
+    SpscQueue<EncoderEvent, QUEUE_SIZE> queue;
+
+    volatile uint8_t lastAB;
+    TaskHandle_t wakeTask;
+    portMUX_TYPE mux;        // Serializes decoding between the ISR and sync()
+
+    static EncoderCapture* instance;
+    static void IRAM_ATTR onEdge();
+    void IRAM_ATTR handleEdge();
+    bool IRAM_ATTR decode();  // Returns true if a step was queued
+};
+
+#endif // ENCODER_CAPTURE_H
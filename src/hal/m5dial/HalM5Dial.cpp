@@ -0,0 +1,194 @@
+/**
+ * M5Dial HAL Implementation
+ */
+
+#include "HalM5Dial.h"
+#include <SPIFFS.h>
+#include <esp_timer.h>
+
+Hal hal = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+
+static M5DialClock clockImpl;
+static M5DialSpeaker speakerImpl;
+static M5DialInput inputImpl;
+static M5DialDisplay displayImpl;
+static SpiffsFileSystem fsImpl;
+static NvsStorage storageImpl;
+static RtcRetainedMemory retainedImpl;
+static PartitionFlash journalImpl("journal");
+static PartitionFlash historyImpl("history");
+
+void installM5DialHal(TaskHandle_t wakeTask) {
+    inputImpl.begin(wakeTask);
+    hal.clock = &clockImpl;
+    hal.speaker = &speakerImpl;
+    hal.input = &inputImpl;
+    hal.display = &displayImpl;
+    hal.fs = &fsImpl;
+    hal.storage = &storageImpl;
+    hal.retained = &retainedImpl;
+    if (!journalImpl.begin()) {
+        Serial.println("Flash: no 'journal' partition - session resume limited to warm resets");
+    }
+    hal.journal = &journalImpl;
+    if (!historyImpl.begin()) {
+        Serial.println("Flash: no 'history' partition - completed sessions are not logged");
+    }
+    hal.history = &historyImpl;
+}
+
+M5DialInput& m5DialInput() {
+    return inputImpl;
+}
+
+// ==================== CLOCK ====================
+uint32_t M5DialClock::millis() {
+    return ::millis();
+}
+
+uint64_t M5DialClock::micros() {
+    return (uint64_t)esp_timer_get_time();
+}
+
+// Firmware build time: no valid RTC reading can be older
+static uint32_t buildSeconds() {
+    static uint32_t seconds = 0;
+    if (seconds == 0) {
+        static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        char month[4] = {};
+        struct tm t = {};
+        sscanf(__DATE__, "%3s %d %d", month, &t.tm_mday, &t.tm_year);
+        sscanf(__TIME__, "%d:%d:%d", &t.tm_hour, &t.tm_min, &t.tm_sec);
+        const char* found = strstr(months, month);
+        t.tm_mon = found ? (found - months) / 3 : 0;
+        t.tm_year -= 1900;
+        time_t built = mktime(&t);
+        seconds = built > 0 ? (uint32_t)built : 1;
+    }
+    return seconds;
+}
+
+uint32_t M5DialClock::wallSeconds() {
+    if (!M5Dial.Rtc.isEnabled()) return 0;
+    // VL (bit 7 of the BM8563 seconds register 0x02): the oscillator stopped or the
+    // backup supply dropped, so the time is garbage until it is set again
+    if (M5Dial.Rtc.getVoltLow()) return 0;
+    struct tm t = M5Dial.Rtc.getDateTime().get_tm();
+    time_t seconds = mktime(&t);
+    // An unset or reset RTC counts from its 2000-01-01 default, before this firmware existed
+    if (seconds <= 0 || (uint32_t)seconds < buildSeconds()) return 0;
+    return (uint32_t)seconds;
+}
+
+// ==================== SPEAKER ====================
+void M5DialSpeaker::tone(uint16_t frequency, uint32_t durationMs) {
+    M5Dial.Speaker.tone(frequency, durationMs);
+}
+
+void M5DialSpeaker::stop() {
+    M5Dial.Speaker.end();
+}
+
+bool M5DialSpeaker::isPlaying() {
+    return M5Dial.Speaker.isPlaying();
+}
+
+// ==================== INPUT ====================
+void M5DialInput::begin(TaskHandle_t wakeTask) {
+    encoder.begin(wakeTask);
+}
+
+void M5DialInput::update() {
+    M5Dial.update();
+}
+
+bool M5DialInput::isButtonPressed() {
+    return M5Dial.BtnA.isPressed();
+}
+
+bool M5DialInput::popEncoderStep(int8_t& step) {
+    EncoderEvent event;
+    if (!encoder.pop(event)) return false;
+    step = event.step;
+    return true;
+}
+
+bool M5DialInput::getTouchPress(int16_t& x, int16_t& y) {
+    auto touch = M5Dial.Touch.getDetail();
+    if (!touch.wasPressed()) return false;
+    x = touch.x;
+    y = touch.y;
+    return true;
+}
+
+uint32_t M5DialInput::getDroppedSteps() {
+    return encoder.getDropped();
+}
+
+// ==================== DISPLAY ====================
+LovyanGFX& M5DialDisplay::panel() {
+    return M5Dial.Display;
+}
+
+void M5DialDisplay::setBrightness(uint8_t level) {
+    M5Dial.Display.setBrightness(level);
+}
+
+// ==================== FILESYSTEM ====================
+uint8_t* SpiffsFileSystem::readFile(const char* path, size_t& length) {
+    File file = SPIFFS.open(path, "r");
+    if (!file) return nullptr;
+
+    length = file.size();
+    uint8_t* data = (uint8_t*)malloc(length);
+    if (data && file.read(data, length) != length) {
+        free(data);
+        data = nullptr;
+    }
+    file.close();
+    return data;
+}
+
+// ==================== STORAGE ====================
+bool NvsStorage::open() {
+    if (!opened) opened = prefs.begin("pomodoro", false);
+    return opened;
+}
+
+bool NvsStorage::load(const char* key, void* data, size_t length) {
+    if (!open() || prefs.getBytesLength(key) != length) return false;
+    return prefs.getBytes(key, data, length) == length;
+}
+
+bool NvsStorage::save(const char* key, const void* data, size_t length) {
+    return open() && prefs.putBytes(key, data, length) == length;
+}
+
+// ==================== RETAINED MEMORY ====================
+static RTC_NOINIT_ATTR uint8_t rtcRetained[64];
+
+void* RtcRetainedMemory::data() {
+    return rtcRetained;
+}
+
+size_t RtcRetainedMemory::size() {
+    return sizeof(rtcRetained);
+}
+
+// ==================== FLASH ====================
+bool PartitionFlash::begin() {
+    partition = esp_partition_find_first(PARTITION_TYPE_POMODORO, ESP_PARTITION_SUBTYPE_ANY, label);
+    return partition != nullptr;
+}
+
+bool PartitionFlash::read(uint32_t offset, void* data, size_t length) {
+    return partition && esp_partition_read(partition, offset, data, length) == ESP_OK;
+}
+
+bool PartitionFlash::write(uint32_t offset, const void* data, size_t length) {
+    return partition && esp_partition_write(partition, offset, data, length) == ESP_OK;
+}
+
+bool PartitionFlash::eraseSector(uint32_t offset) {
+    return partition && esp_partition_erase_range(partition, offset, FLASH_SECTOR_SIZE) == ESP_OK;
+}
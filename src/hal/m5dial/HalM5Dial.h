@@ -0,0 +1,103 @@
+/**
+ * M5Dial HAL Implementation
+ * Routes the HAL interfaces to M5Dial, esp_timer, the encoder ISR, SPIFFS, NVS,
+ * RTC memory and raw flash partitions
+ */
+
+#ifndef HAL_M5DIAL_H
+#define HAL_M5DIAL_H
+
+#include <Arduino.h>
+#include <M5Dial.h>
+#include <Preferences.h>
+#include <esp_partition.h>
+#include "hal/Hal.h"
+#include "EncoderCapture.h"
+
+class M5DialClock : public HalClock {
+public:
+    uint32_t millis() override;
+    uint64_t micros() override;
+    uint32_t wallSeconds() override;     // BM8563 RTC over I2C; 0 if it lost power or was never set
+};
+
+class M5DialSpeaker : public HalSpeaker {
+public:
+    void tone(uint16_t frequency, uint32_t durationMs) override;
+    void stop() override;
+    bool isPlaying() override;
+};
+
+class M5DialInput : public HalInput {
+public:
+    // Start encoder capture; wakeTask is notified on every detent
+    void begin(TaskHandle_t wakeTask);
+
+    void update() override;
+    bool isButtonPressed() override;
+    bool popEncoderStep(int8_t& step) override;
+    bool getTouchPress(int16_t& x, int16_t& y) override;
+    uint32_t getDroppedSteps() override;
+
+    // Decode an encoder transition that had no interrupt (light-sleep wake)
+    void syncEncoder() { encoder.sync(); }
+
+private:
+    EncoderCapture encoder;
+};
+
+class M5DialDisplay : public HalDisplay {
+public:
+    LovyanGFX& panel() override;
+    void setBrightness(uint8_t level) override;
+};
+
+class SpiffsFileSystem : public HalFileSystem {
+public:
+    uint8_t* readFile(const char* path, size_t& length) override;
+};
+
+class NvsStorage : public HalStorage {
+public:
+    NvsStorage() : opened(false) {}
+    bool load(const char* key, void* data, size_t length) override;
+    bool save(const char* key, const void* data, size_t length) override;
+
+private:
+    Preferences prefs;       // "pomodoro" namespace, opened on first use
+    bool opened;
+    bool open();
+};
+
+// 64 bytes of RTC slow memory, left alone by the bootloader on warm resets
+class RtcRetainedMemory : public HalRetainedMemory {
+public:
+    void* data() override;
+    size_t size() override;
+};
+
+// Custom type of the app's raw data partitions (see partitions.csv)
+static const esp_partition_type_t PARTITION_TYPE_POMODORO = (esp_partition_type_t)0x40;
+
+// Data partition looked up by label in partitions.csv
+class PartitionFlash : public HalFlash {
+public:
+    explicit PartitionFlash(const char* label) : label(label), partition(nullptr) {}
+    bool begin();
+    uint32_t size() override { return partition ? partition->size : 0; }
+    bool read(uint32_t offset, void* data, size_t length) override;
+    bool write(uint32_t offset, const void* data, size_t length) override;
+    bool eraseSector(uint32_t offset) override;
+
+private:
+    const char* label;
+    const esp_partition_t* partition;
+};
+
+// Install the M5Dial implementations into `hal` (call after M5Dial.begin and SPIFFS.begin)
+void installM5DialHal(TaskHandle_t wakeTask);
+
+// Device input, for the light-sleep resync in main.cpp
+M5DialInput& m5DialInput();
+
+#endif // HAL_M5DIAL_H
@@ -0,0 +1,71 @@
+/**
+ * Power Manager Implementation
+ * The panel keeps its own frame memory, so nothing is redrawn after a wake-up
+ */
+
+#include "PowerManager.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+// Any input wakes the chip; each pin gets its own interrupt edge back after the wake
+struct WakePin {
+    uint8_t pin;
+    gpio_int_type_t edge;     // As attached in setup() / EncoderCapture::begin()
+};
+static const WakePin WAKE_PINS[] = {
+    { BUTTON_PIN, GPIO_INTR_ANYEDGE },
+    { ENCODER_PIN_A, GPIO_INTR_ANYEDGE },
+    { ENCODER_PIN_B, GPIO_INTR_ANYEDGE },
+    { TOUCH_INT_PIN, GPIO_INTR_NEGEDGE }
+};
+static const uint8_t WAKE_PIN_COUNT = sizeof(WAKE_PINS) / sizeof(WAKE_PINS[0]);
+
+PowerManager::PowerManager()
+    : wakeups(0),
+      gpioWakeups(0),
+      sleepTimeUs(0) {
+}
+
+bool PowerManager::lightSleep(uint32_t timeoutMs) {
+    if (timeoutMs == 0) return false;
+
+    // UINT32_MAX: nothing scheduled, only input ends the sleep
+    if (timeoutMs != UINT32_MAX) esp_sleep_enable_timer_wakeup((uint64_t)timeoutMs * 1000ULL);
+    armWakePins();
+    esp_sleep_enable_gpio_wakeup();
+    Serial.flush(); // Don't cut off pending output
+
+    uint64_t start = esp_timer_get_time();
+    esp_light_sleep_start();
+    sleepTimeUs += esp_timer_get_time() - start;
+    wakeups++;
+
+    bool byGpio = (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO);
+    restorePinInterrupts();
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+
+    if (byGpio) gpioWakeups++;
+    return byGpio;
+}
+
+void PowerManager::armWakePins() {
+    // GPIO wake is level-triggered: wake when a pin leaves its current level.
+    // The pin interrupts are masked meanwhile so a held level can't storm the ISR.
+    for (uint8_t i = 0; i < WAKE_PIN_COUNT; i++) {
+        gpio_num_t pin = (gpio_num_t)WAKE_PINS[i].pin;
+        gpio_intr_disable(pin);
+        gpio_wakeup_enable(pin, gpio_get_level(pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+}
+
+void PowerManager::restorePinInterrupts() {
+    // gpio_wakeup_enable() replaced the edge interrupts with level ones
+    for (uint8_t i = 0; i < WAKE_PIN_COUNT; i++) {
+        gpio_num_t pin = (gpio_num_t)WAKE_PINS[i].pin;
+        gpio_wakeup_disable(pin);
+        gpio_set_intr_type(pin, WAKE_PINS[i].edge);
+        gpio_intr_enable(pin);
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * Power Manager Module
+ * Light sleep between events while the timer is not counting
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+class PowerManager {
+public:
+    // Constructor
+    PowerManager();
+
+    // Enter light sleep for up to timeoutMs (UINT32_MAX = until input); wakes early on
+    // the button, encoder or touch panel. Returns true if woken by a GPIO (user input),
+    // false on timeout.
+    bool lightSleep(uint32_t timeoutMs);
+
+    // Statistics (for performance monitoring)
+    uint32_t getWakeups() const { return wakeups; }
+    uint32_t getGpioWakeups() const { return gpioWakeups; }
+    uint64_t getSleepTimeUs() const { return sleepTimeUs; }
+    void resetStats() { wakeups = 0; gpioWakeups = 0; sleepTimeUs = 0; }
+
+private:
+    uint32_t wakeups;
+    uint32_t gpioWakeups;
+    uint64_t sleepTimeUs;
+
+    void armWakePins();
+    void restorePinInterrupts();
+};
+
+#endif // POWER_MANAGER_H
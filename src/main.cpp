@@ -1,43 +1,42 @@
 #include <Arduino.h>
 #include <M5Dial.h>
-#include <math.h>
-#include <string.h>
 #include <SPIFFS.h>
+#include <esp_system.h>
 #include "config.h"
 #include "types.h"
-#include "Display.h"
-#include "InputHandler.h"
-#include "TimerManager.h"
-
-
-// Global Variables
-TimerState currentState = STATE_IDLE;
-PomodoroSettings settings = {
-    .workDuration = 25 * 60,           // 25 minutes
-    .shortBreakDuration = 5 * 60,      // 5 minutes
-    .longBreakDuration = 25 * 60,      // 25 minutes
-    .pomodorosUntilLongBreak = 4,
-    .brightnessLevel = 3               // Mid brightness (level 3 of 6)
-};
-
-uint8_t completedPomodoros = 0;
-uint8_t settingsMenuIndex = 0;
-bool settingsEditing = false;
-bool needsRedraw = true;
-uint32_t lastDisplayedSeconds = 0;
-TimerState lastDisplayedState = STATE_SETTINGS; // Initialize to different state to force first draw
-float lastDisplayedProgress = -1.0;
-
-// Module instances
-Display display;
-InputHandler inputHandler;
-TimerManager timerManager;
-
-// Function prototypes (callback wrappers for InputHandler)
-void startTimer(uint32_t duration);
-void pauseTimer();
-void resumeTimer();
-void resetTimer();
+#include "App.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include "hal/m5dial/HalM5Dial.h"
+#include "hal/m5dial/PowerManager.h"
+
+
+// Application (state machine, input, timer and display) and device power control
+PomodoroApp app;
+PowerManager powerManager;
+
+// Event loop: the loop task sleeps until its next deadline or an input edge
+TaskHandle_t loopTaskHandle = nullptr;
+void IRAM_ATTR onInputInterrupt();
+void IRAM_ATTR onTouchInterrupt();
+bool waitForEvent(uint32_t timeoutMs);
+void flushSettings();
+
+// Storage task: flash writes the loop task queued
+TaskHandle_t storageTaskHandle = nullptr;
+void storageTask(void* param);
+void wakeStorageTask();
+
+#if ENABLE_DUAL_CORE
+// Render task: draws whatever the loop task last published
+TaskHandle_t renderTaskHandle = nullptr;
+void renderTask(void* param);
+void wakeRenderTask();
+#endif
+
+#if ENABLE_TRACE
+void serviceTraceDump();
+#endif
 
 void setup() {
     Serial.begin(115200);
@@ -47,7 +46,7 @@ void setup() {
     Serial.println("╚═══════════════════════════════════════════╝\n");
     
     auto cfg = M5.config();
-    M5Dial.begin(cfg, true, true);
+    M5Dial.begin(cfg, false, true); // Encoder is decoded by EncoderCapture, not the M5Dial driver
     
     // Initialize SPIFFS for image loading
     if (!SPIFFS.begin(true)) {
@@ -67,160 +66,212 @@ void setup() {
         }
     }
     
-    M5Dial.Display.setBrightness((settings.brightnessLevel * 255) / 6);
     M5Dial.Display.setRotation(0);
-    M5Dial.Display.fillScreen(COLOR_WORK_BG); // Start with red background
     
-    // Initialize input handler
-    inputHandler.init();
+    // Route the HAL to the M5Dial; encoder steps, button edges and touches wake
+    // the loop immediately, so it never has to poll for them
+    loopTaskHandle = xTaskGetCurrentTaskHandle();
+    installM5DialHal(loopTaskHandle);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onInputInterrupt, CHANGE);
+    pinMode(TOUCH_INT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(TOUCH_INT_PIN), onTouchInterrupt, FALLING);
+    
+    app.begin();
+    // A settings change still in its quiet period is written before a software restart
+    esp_register_shutdown_handler(flushSettings);
     
-    // Draw initial screen
-    needsRedraw = true;
-    resetTimer();
+    // Input and timer never wait out a flash erase: the loop task only queues
+    // journal and history writes, a lower-priority task makes them
+    vTaskPrioritySet(nullptr, CONTROL_TASK_PRIORITY);
+    xTaskCreate(storageTask, "storage", STORAGE_TASK_STACK, nullptr,
+                STORAGE_TASK_PRIORITY, &storageTaskHandle);
+    app.setStorageWake(wakeStorageTask);
+    
+    #if ENABLE_DUAL_CORE
+    // Timing and input must never wait behind a slow draw: rendering moves to
+    // the other core, the loop task keeps input, timer and alarm at higher priority
+    xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK, nullptr,
+                            RENDER_TASK_PRIORITY, &renderTaskHandle, RENDER_TASK_CORE);
+    app.setRenderWake(wakeRenderTask);
+    #endif
 }
 
 void loop() {
-    M5Dial.update();
-    
-    // Performance monitoring (optional debug mode)
-    #if ENABLE_PERFORMANCE_MONITOR
-    static uint32_t loopCount = 0;
-    static uint32_t lastPerfReport = 0;
-    static uint32_t redrawCount = 0;
-    static uint32_t skippedFrames = 0;
-    loopCount++;
+    // Input and timer (plus the redraw when single-core); returns how long nothing needs doing
+    uint32_t sleepMs = app.stepControl();
+    #if !ENABLE_DUAL_CORE
+    sleepMs = min(sleepMs, app.stepRender());
     #endif
     
-    // Get current timer values for input handler
-    uint32_t timerRemaining = timerManager.getRemaining();
-    uint32_t timerDuration = timerManager.getDuration();
-    
-    // Store old state to detect reset
-    TimerState oldState = currentState;
-    
-    // Handle all input (encoder, button, touch) through InputHandler
-    inputHandler.processInput(currentState, settings, settingsMenuIndex, settingsEditing,
-                              timerRemaining, timerDuration, needsRedraw,
-                              startTimer, pauseTimer, resumeTimer, resetTimer);
-    
-    // Only sync back if we're in IDLE state (encoder adjustments)
-    // If reset happened (state changed to IDLE), re-read values instead
-    if (currentState == STATE_IDLE && oldState == STATE_IDLE) {
-        // Dial was adjusted in idle - sync changes back
-        timerManager.setRemaining(timerRemaining);
-        timerManager.setDuration(timerDuration);
-    }
-    
-    // Update timer logic (including buzzer)
-    timerManager.update(currentState, settings, completedPomodoros, needsRedraw);
-    
-    // Get current timer values for display
-    uint32_t currentRemaining = timerManager.getRemaining();
-    uint32_t currentDuration = timerManager.getDuration();
-    
-    // Check if we need to redraw (only when something changes)
-    bool shouldRedraw = needsRedraw;
-    if (currentState == STATE_RUNNING || currentState == STATE_SHORT_BREAK || currentState == STATE_LONG_BREAK) {
-        // Update every second for timer, or immediately if state changed
-        if (currentRemaining != lastDisplayedSeconds || currentState != lastDisplayedState) {
-            shouldRedraw = true;
-        }
-    } else if (currentState == STATE_IDLE) {
-        // In idle, redraw if state changed or if timer duration changed (from dial adjustment)
-        if (currentState != lastDisplayedState || currentRemaining != lastDisplayedSeconds) {
-            shouldRedraw = true;
-        }
-    } else if (currentState != lastDisplayedState) {
-        shouldRedraw = true;
-    }
-    
-    // Always redraw status text when state changes
-    if (currentState != lastDisplayedState) {
-        shouldRedraw = true;
-    }
-    
-    // Redraw display when needed
-    // Performance optimization: Frame rate limiting
-    static uint32_t lastRedrawTime = 0;
-    uint32_t redrawNow = millis();
-    bool canRedraw = (redrawNow - lastRedrawTime >= MIN_REDRAW_INTERVAL_MS);
-    
-    if (shouldRedraw && canRedraw) {
-        lastRedrawTime = redrawNow;
-        #if ENABLE_PERFORMANCE_MONITOR
-        redrawCount++;
-        #endif
-        switch (currentState) {
-            case STATE_IDLE:
-            case STATE_RUNNING:
-            case STATE_PAUSED:
-            case STATE_SHORT_BREAK:
-            case STATE_LONG_BREAK:
-                display.drawTimerDisplay(currentRemaining, display.getStateColor(currentState),
-                                        currentState, currentDuration, currentRemaining,
-                                        lastDisplayedState, lastDisplayedProgress);
-                display.drawStatusText(
-                    currentState == STATE_IDLE ? "Ready" :
-                    currentState == STATE_PAUSED ? "Paused" :
-                    currentState == STATE_RUNNING ? "Focusing" :
-                    currentState == STATE_SHORT_BREAK ? "Short Break" :
-                    "Long Break",
-                    display.getStateColor(currentState),
-                    currentState, lastDisplayedState
-                );
-                display.drawPomodoroCounter(completedPomodoros, currentState);
-                display.drawTomatoIcon(currentState);
-                break;
-            case STATE_SETTINGS:
-                display.drawSettingsMenu(settings, settingsMenuIndex, settingsEditing, lastDisplayedState);
-                break;
-        }
-        lastDisplayedSeconds = currentRemaining;
-        lastDisplayedState = currentState;
-        needsRedraw = false;
-    } else if (shouldRedraw && !canRedraw) {
-        #if ENABLE_PERFORMANCE_MONITOR
-        skippedFrames++;
-        #endif
-    }
+    #if ENABLE_TRACE
+    serviceTraceDump();
+    #endif
     
     // Performance monitoring: Periodic reporting
     #if ENABLE_PERFORMANCE_MONITOR
+    static uint32_t lastPerfReport = 0;
     uint32_t now = millis();
     if (now - lastPerfReport >= PERF_REPORT_INTERVAL_MS) {
-        float fps = (float)loopCount / (float)(now - lastPerfReport) * 1000.0f;
-        float redrawFps = (float)redrawCount / (float)(now - lastPerfReport) * 1000.0f;
+        float fps = (float)app.getLoopCount() / (float)(now - lastPerfReport) * 1000.0f;
+        float redrawFps = (float)app.getRedrawCount() / (float)(now - lastPerfReport) * 1000.0f;
         Serial.println("\n═══ PERFORMANCE STATS ═══");
         Serial.print("Loop FPS: "); Serial.println(fps, 1);
         Serial.print("Redraw FPS: "); Serial.println(redrawFps, 1);
-        Serial.print("Skipped Frames: "); Serial.println(skippedFrames);
+        Serial.print("Skipped Frames: "); Serial.println(app.getSkippedFrames());
+        const LatencyStats& inputLatency = app.getInputLatency();
+        const LatencyStats& tickLatency = app.getTickLatency();
+        Serial.print("Button -> State: "); Serial.print(inputLatency.averageUs());
+        Serial.print(" us avg, "); Serial.print(inputLatency.maxUs); Serial.println(" us max");
+        Serial.print("Second -> Pixels: "); Serial.print(tickLatency.averageUs());
+        Serial.print(" us avg, "); Serial.print(tickLatency.maxUs); Serial.println(" us max");
+        Serial.print("Encoder Steps Dropped: "); Serial.println(app.getInputHandler().getEncoderDropped());
+        uint32_t interval = now - lastPerfReport;
+        Serial.print("Light Sleep Wakeups/min: ");
+        Serial.print(powerManager.getWakeups() * 60000UL / interval);
+        Serial.print(" (input: "); Serial.print(powerManager.getGpioWakeups()); Serial.println(")");
+        Serial.print("Time Asleep: ");
+        Serial.print((uint32_t)(powerManager.getSleepTimeUs() / 10ULL / interval)); Serial.println("%");
+        Serial.print("Frames Pushed: "); Serial.println(app.getDisplay().getFramesPushed());
+        Serial.print("SPI Bytes Pushed: "); Serial.println(app.getDisplay().getBytesPushed());
+        Serial.print("Back Buffer: "); Serial.println(app.getDisplay().isBuffered() ? "sprite" : "direct");
+        const IconCache& icons = app.getDisplay().getIconCache();
+        Serial.print("Icon Load: "); Serial.print(icons.getLoadTimeUs()); Serial.println(" us");
+        Serial.print("Icon Blits: "); Serial.print(icons.getBlitCount());
+        Serial.print(" ("); Serial.print(icons.getBlitCount() ? icons.getBlitTimeUs() / icons.getBlitCount() : 0); Serial.println(" us avg)");
+        Serial.print("Glyph Blits: "); Serial.print(app.getDisplay().getGlyphAtlas().getBlitCount());
+        Serial.print(" (atlas builds: "); Serial.print(app.getDisplay().getGlyphAtlas().getBuildCount()); Serial.println(")");
+        const SettingsStore& settingsStore = app.getSettingsStore();
+        Serial.print("Settings Writes: "); Serial.print(settingsStore.getWriteCount());
+        Serial.print(" (~"); Serial.print(settingsStore.getEstimatedEraseCycles()); Serial.println(" NVS erase cycles)");
+        SessionCheckpoint& checkpoint = app.getCheckpoint();
+        Serial.print("Checkpoints: "); Serial.print(checkpoint.getRtcWrites());
+        Serial.print(" RTC, "); Serial.print(checkpoint.getFlashWrites());
+        Serial.print(" flash, "); Serial.print(checkpoint.getFlashErases()); Serial.println(" erases");
+        Serial.print("Checkpoint Cost: "); Serial.print(checkpoint.getCostUsPerSecond());
+        Serial.print(" us per counting s (budget "); Serial.print(CHECKPOINT_BUDGET_US_PER_S); Serial.println(")");
+        const SessionHistory& history = app.getHistory();
+        Serial.print("History: "); Serial.print(history.getAppendCount());
+        Serial.print(" sessions, "); Serial.print(history.getBytesWritten());
+        Serial.print(" bytes, "); Serial.print(history.getSectorErases()); Serial.print(" erases, ");
+        Serial.print(history.getDropped()); Serial.println(" lost");
         Serial.print("Free Heap: "); Serial.print(ESP.getFreeHeap()); Serial.println(" bytes");
+        // Largest free block vs. free heap shows fragmentation from long uptimes
+        uint32_t freeHeap = ESP.getFreeHeap();
+        uint32_t largestBlock = ESP.getMaxAllocHeap();
+        Serial.print("Largest Free Block: "); Serial.print(largestBlock); Serial.println(" bytes");
+        Serial.print("Min Free Heap: "); Serial.print(ESP.getMinFreeHeap()); Serial.println(" bytes");
+        Serial.print("Heap Fragmentation: ");
+        Serial.print(freeHeap ? 100 - (largestBlock * 100) / freeHeap : 0); Serial.println("%");
         Serial.println("═══════════════════════════\n");
+        // Per-phase loop timing (machine-parsable CSV)
+        profiler.report(interval);
+        profiler.reset();
         
-        loopCount = 0;
-        redrawCount = 0;
-        skippedFrames = 0;
+        // Counters written by the render and storage tasks are reset by those tasks
+        app.resetStats();
+        checkpoint.resetStats();
+        powerManager.resetStats();
         lastPerfReport = now;
     }
+    sleepMs = min(sleepMs, PERF_REPORT_INTERVAL_MS - (now - lastPerfReport));
     #endif
     
-    // Balanced loop delay for responsiveness and efficiency
-    delay(10);
+    // Nothing counts down while Ready or Paused: light sleep instead of idling,
+    // unless the user is mid-interaction or a click/redraw/flash write is still in flight
+    TimerState currentState = app.getState();
+    bool sleepState = ENABLE_LIGHT_SLEEP &&
+                      (currentState == STATE_IDLE || currentState == STATE_PAUSED) &&
+                      app.getInputHandler().isQuiet();
+    bool busy = app.isRedrawPending() || app.isStoragePending() || hal.speaker->isPlaying();
+    if (sleepState && !busy) {
+        // The battery may run out while asleep: don't hold a settings change in RAM
+        flushSettings();
+        if (powerManager.lightSleep(sleepMs)) {
+            m5DialInput().syncEncoder(); // The waking edge had no interrupt
+            app.getInputHandler().noteActivity();
+        }
+        return;
+    }
+    // Nothing announces the end of a redraw, click or write: check back for light sleep soon
+    if (sleepState) sleepMs = min<uint32_t>(sleepMs, LOOP_DELAY_ACTIVE);
+    #if ENABLE_TRACE
+    // Serial can't wake the loop; in light sleep a dump request waits for the next wake
+    sleepMs = min<uint32_t>(sleepMs, SERIAL_POLL_MS);
+    #endif
+    if (waitForEvent(sleepMs)) {
+        app.getInputHandler().noteActivity();
+    }
+}
+
+// Wake the loop task from the button GPIO interrupt
+void IRAM_ATTR onInputInterrupt() {
+    app.noteInputEdge(micros());
+    BaseType_t higherPriorityWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(loopTaskHandle, &higherPriorityWoken);
+    if (higherPriorityWoken) {
+        portYIELD_FROM_ISR();
+    }
 }
 
-// Callback wrappers for InputHandler to call TimerManager
-void startTimer(uint32_t duration) {
-    timerManager.start(duration, currentState);
+// Wake the loop task from the touch controller's interrupt line
+void IRAM_ATTR onTouchInterrupt() {
+    BaseType_t higherPriorityWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(loopTaskHandle, &higherPriorityWoken);
+    if (higherPriorityWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+// Write a pending settings change now instead of after the commit delay
+void flushSettings() {
+    app.getSettingsStore().flush();
+}
+
+// Block until timeout (UINT32_MAX = none) or an input interrupt; returns true if woken by input
+bool waitForEvent(uint32_t timeoutMs) {
+    if (timeoutMs == 0) return false;
+    TickType_t ticks = timeoutMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return ulTaskNotifyTake(pdTRUE, ticks) > 0;
+}
+
+void storageTask(void* param) {
+    for (;;) {
+        // Write whatever is queued, then sleep until the loop task queues more
+        // (or until a failed history append is due for another try)
+        app.stepStorage();
+        TickType_t wait = app.getHistory().isPending() ? pdMS_TO_TICKS(HISTORY_RETRY_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+void wakeStorageTask() {
+    xTaskNotifyGive(storageTaskHandle);
+}
+
+#if ENABLE_DUAL_CORE
+void renderTask(void* param) {
+    for (;;) {
+        // Draw the latest snapshot, then sleep until the next publish (or a throttled redraw is due)
+        uint32_t waitMs = app.stepRender();
+        ulTaskNotifyTake(pdTRUE, waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs));
+    }
 }
 
-void pauseTimer() {
-    timerManager.pause(currentState);
+void wakeRenderTask() {
+    xTaskNotifyGive(renderTaskHandle);
 }
+#endif
 
-void resumeTimer() {
-    timerManager.resume(currentState);
+#if ENABLE_TRACE
+static void writeToSerial(const uint8_t* data, size_t length, void* context) {
+    Serial.write(data, length);
 }
 
-void resetTimer() {
-    timerManager.reset(currentState, settings);
+// Send the trace ring as a binary dump when 't' arrives over Serial
+// (decode on the host: program decode <capture> [--chrome])
+void serviceTraceDump() {
+    if (!Serial.available() || Serial.read() != 't') return;
+    tracer.dump(writeToSerial, nullptr);
+    Serial.flush();
 }
+#endif
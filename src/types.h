@@ -15,8 +15,10 @@ enum TimerState {
     STATE_PAUSED,
     STATE_SHORT_BREAK,
     STATE_LONG_BREAK,
-    STATE_SETTINGS
+    STATE_SETTINGS,
+    STATE_STATS
 };
+const uint8_t STATE_COUNT = STATE_STATS + 1;   // Size of tables indexed by TimerState
 
 // Settings Structure
 struct PomodoroSettings {
@@ -25,6 +27,45 @@ struct PomodoroSettings {
     uint16_t longBreakDuration;      // Long break duration in seconds (default: 25 min)
     uint8_t pomodorosUntilLongBreak; // Number of pomodoros before long break (default: 4)
     uint8_t brightnessLevel;         // Display brightness level 1-6 (default: 3)
+    uint8_t themeIndex;              // Display theme, index into THEMES (default: 0, Classic)
+};
+
+// Everything needed to continue a session after a reset (see SessionCheckpoint)
+struct SessionSnapshot {
+    uint8_t state;                   // TimerState; STATE_IDLE when nothing is in progress
+    uint8_t stateBeforePause;        // TimerState resumed from STATE_PAUSED
+    uint8_t completedPomodoros;
+    uint8_t pomodorosSinceLongBreak;
+    uint32_t duration;               // Session length in seconds
+    uint32_t elapsedMs;              // Time counted so far
+    uint32_t lastPomodoroDuration;   // Work length reused after a short break
+};
+
+// Figures shown on the statistics screen (see FocusStats)
+struct StatsSummary {
+    bool wallClock;                  // Calendar figures below are valid
+    uint32_t todaySeconds;           // Focus time today
+    uint32_t weekSeconds;            // Focus time this week (from Monday)
+    uint32_t monthSeconds;           // Focus time this calendar month
+    uint16_t streakDays;             // Consecutive days with a focus session, up to today
+    uint16_t bestStreakDays;
+    uint32_t focusSessions;          // Work sessions completed, ever
+    uint32_t averageSeconds;         // Average work session length
+};
+
+// Everything the renderer needs, published by the control side (see PomodoroApp)
+struct DisplaySnapshot {
+    TimerState state;
+    uint32_t remaining;
+    uint32_t duration;
+    uint16_t arcStep;       // Progress in arc steps (0-PROGRESS_ARC_STEPS)
+    uint8_t completedPomodoros;
+    PomodoroSettings settings;
+    uint8_t settingsMenuIndex;
+    bool settingsEditing;
+    StatsSummary stats;
+    uint32_t version;       // Bumped whenever the visible content changed
+    uint32_t tickUs;        // micros() of the second boundary behind this version (0 = not a tick)
 };
 
 #endif // TYPES_H
@@ -0,0 +1,140 @@
+/**
+ * Completion Alarm Tests (pio test -e native -f test_beep)
+ * Runs a session to completion on the host's virtual clock and checks every
+ * speaker on/off time of the alarm against the beep pattern, both when the
+ * loop wakes exactly at TimerManager's deadlines and when it wakes late
+ */
+
+#include <unity.h>
+#include "TimerManager.h"
+#include "hal/host/HalHost.h"
+
+static const uint32_t SESSION_S = 60;
+static const uint32_t ALARM_DELAY_MS = 1000;    // 00:00 stays on screen this long first
+
+// Speaker calls from the start of the alarm (ms after it, frequency, duration; 0 Hz = stop)
+static const SpeakerEvent EXPECTED[] = {
+    {    0,    0,   0 },                          // Settle pause
+    {   50, 3000, 250 }, {  300, 0, 0 },
+    {  600, 3000, 250 }, {  850, 0, 0 },
+    { 1150, 3000, 250 }, { 1400, 0, 0 },
+    { 1700, 3000, 250 }, { 1950, 0, 0 },
+    { 2250, 3000, 400 },                          // Long beep
+    { 2650,    0,   0 },                          // Sequence done
+};
+static const size_t EXPECTED_COUNT = sizeof(EXPECTED) / sizeof(EXPECTED[0]);
+
+static HostPlatform* platform;
+
+struct Session {
+    TimerManager timer;
+    TimerState state;
+    PomodoroSettings settings;
+    uint8_t completedPomodoros;
+    bool needsRedraw;
+
+    Session() : timer(), state(STATE_IDLE), completedPomodoros(0), needsRedraw(false) {
+        settings.workDuration = SESSION_S;
+        settings.shortBreakDuration = 5 * 60;
+        settings.longBreakDuration = 25 * 60;
+        settings.pomodorosUntilLongBreak = 4;
+        settings.brightnessLevel = 3;
+        settings.themeIndex = 0;
+    }
+
+    void update() { timer.update(state, settings, completedPomodoros, needsRedraw); }
+};
+
+// Step the clock until the session hands over to the break; lateMs = 0 wakes exactly
+// at each deadline, otherwise the loop wakes every lateMs instead
+static void runToBreak(Session& s, uint32_t lateMs) {
+    uint32_t limit = platform->clock.millis() + (SESSION_S + 10) * 1000;
+    while (s.state == STATE_RUNNING && platform->clock.millis() < limit) {
+        uint32_t sleepMs = lateMs ? lateMs : s.timer.getMsUntilNextEvent(s.state);
+        platform->clock.advanceMs(sleepMs > 0 ? sleepMs : 1);
+        s.update();
+    }
+}
+
+// Every speaker call lands within toleranceMs after its slot in the pattern
+static void checkPattern(uint32_t alarmStartMs, uint32_t toleranceMs) {
+    const std::vector<SpeakerEvent>& events = platform->speaker.getEvents();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(EXPECTED_COUNT, events.size(), "speaker calls in one alarm");
+    char message[64];
+    for (size_t i = 0; i < EXPECTED_COUNT; i++) {
+        uint32_t dueMs = alarmStartMs + EXPECTED[i].atMs;
+        snprintf(message, sizeof(message), "step %u at +%lu ms", (unsigned)i, (unsigned long)EXPECTED[i].atMs);
+        TEST_ASSERT_TRUE_MESSAGE(events[i].atMs >= dueMs && events[i].atMs <= dueMs + toleranceMs, message);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(EXPECTED[i].frequency, events[i].frequency, message);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(EXPECTED[i].durationMs, events[i].durationMs, message);
+    }
+}
+
+void setUp() {
+    platform->clock.advanceMs(1234);    // Sessions don't start on a round number
+    platform->speaker.clearEvents();
+}
+
+void tearDown() {}
+
+static void test_alarm_follows_pattern_at_deadlines() {
+    Session s;
+    s.timer.start(SESSION_S, s.state);
+    uint32_t completionMs = platform->clock.millis() + SESSION_S * 1000;
+    runToBreak(s, 0);
+
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_SHORT_BREAK, s.state, "session hands over to the break");
+    TEST_ASSERT_EQUAL_UINT8(1, s.completedPomodoros);
+    checkPattern(completionMs + ALARM_DELAY_MS, 0);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(completionMs + ALARM_DELAY_MS + 2650, platform->clock.millis(),
+                                     "break starts as the last beep ends");
+}
+
+// A loop that wakes late starts each step late, but later steps keep their slots
+static void test_late_loop_keeps_step_boundaries() {
+    const uint32_t lateMs = 7;
+    Session s;
+    s.timer.start(SESSION_S, s.state);
+    uint32_t completionMs = platform->clock.millis() + SESSION_S * 1000;
+    runToBreak(s, lateMs);
+
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_SHORT_BREAK, s.state, "session hands over to the break");
+    const std::vector<SpeakerEvent>& events = platform->speaker.getEvents();
+    TEST_ASSERT_FALSE(events.empty());
+    uint32_t alarmStartMs = events[0].atMs;
+    TEST_ASSERT_TRUE_MESSAGE(alarmStartMs >= completionMs + ALARM_DELAY_MS &&
+                             alarmStartMs < completionMs + ALARM_DELAY_MS + 2 * lateMs,
+                             "alarm starts a second after 00:00");
+    checkPattern(alarmStartMs, lateMs - 1);
+}
+
+// A press while it sounds stops the speaker at once; the break follows on the next update
+static void test_silenced_alarm_stops_at_once() {
+    Session s;
+    s.timer.start(SESSION_S, s.state);
+    uint32_t alarmStartMs = platform->clock.millis() + SESSION_S * 1000 + ALARM_DELAY_MS;
+    while (platform->clock.millis() < alarmStartMs + 700) {
+        uint32_t sleepMs = s.timer.getMsUntilNextEvent(s.state);
+        platform->clock.advanceMs(min<uint32_t>(sleepMs > 0 ? sleepMs : 1, alarmStartMs + 700 - platform->clock.millis()));
+        s.update();
+    }
+    TEST_ASSERT_TRUE(s.timer.isAlarmActive());
+    s.timer.silenceAlarm();
+
+    const std::vector<SpeakerEvent>& events = platform->speaker.getEvents();
+    TEST_ASSERT_EQUAL_UINT16(0, events.back().frequency);
+    TEST_ASSERT_EQUAL_UINT32(alarmStartMs + 700, events.back().atMs);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, s.timer.getMsUntilNextEvent(s.state), "session switch due immediately");
+    s.update();
+    TEST_ASSERT_EQUAL(STATE_SHORT_BREAK, s.state);
+    TEST_ASSERT_FALSE(s.timer.isAlarmActive());
+}
+
+int main() {
+    platform = &installHostHal();
+    UNITY_BEGIN();
+    RUN_TEST(test_alarm_follows_pattern_at_deadlines);
+    RUN_TEST(test_late_loop_keeps_step_boundaries);
+    RUN_TEST(test_silenced_alarm_stops_at_once);
+    return UNITY_END();
+}
@@ -0,0 +1,131 @@
+/**
+ * Encoder Replay Tests (pio test -e native -f test_encoder_replay)
+ * Replays a dial recording (spins, flicks faster than the loop wakes, slow
+ * turns and jitter on a detent) into the app while it edits the work
+ * duration, and checks after every run that no step was lost or applied
+ * twice. The ring itself is the one the device's EncoderCapture uses.
+ */
+
+#include <unity.h>
+#include "App.h"
+#include "SpscQueue.h"
+#include "hal/host/AppDriver.h"
+#include "hal/host/HalHost.h"
+
+// A run of detents in one direction; intervalMs 0 = all at once (one burst)
+struct DetentRun {
+    uint16_t count;
+    int8_t step;
+    uint16_t intervalMs;
+    uint16_t pauseAfterMs;
+};
+
+// Starts from the 25 min default and stays inside 1..60 min, so no step is clamped
+static const DetentRun RECORDING[] = {
+    { 20, -1,  40,  300 },  // Brisk spin down to 5 min
+    { 30, +1,   0,  500 },  // Flick: 30 detents before the loop wakes once
+    {  6, -1, 120,  200 },  // Back off slowly
+    {  1, +1,   0,   15 },  // Jitter on a detent boundary
+    {  1, -1,   0,   15 },
+    {  1, +1,   0,   15 },
+    {  1, -1,   0,  400 },
+    { 20, +1,   3,  250 },  // Faster than the 10 ms active poll
+    { 15, -1,  25, 2000 },  // Settle on 34 min
+};
+static const size_t RUN_COUNT = sizeof(RECORDING) / sizeof(RECORDING[0]);
+
+static HostPlatform* platform;
+
+// Let the loop run for ms: a queued detent wakes it at once (as the encoder ISR's
+// notification does), otherwise it sleeps until its own next deadline
+static void runLoop(PomodoroApp& app, uint32_t ms) {
+    uint32_t end = platform->clock.millis() + ms;
+    uint32_t sleepMs = app.step();
+    while (platform->clock.millis() < end) {
+        platform->clock.advanceMs(max<uint32_t>(1, min(sleepMs, end - platform->clock.millis())));
+        sleepMs = app.step();
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ==================== QUEUE ====================
+static void test_queue_keeps_order_across_index_wrap() {
+    SpscQueue<uint16_t, 64> queue;
+    uint16_t pushed = 0, popped = 0;
+    // Batches of 1..64 items: the 8-bit indices wrap many times
+    for (uint16_t round = 0; round < 500; round++) {
+        uint16_t batch = 1 + (round * 37) % 64;
+        for (uint16_t i = 0; i < batch; i++) {
+            TEST_ASSERT_TRUE(queue.push(pushed++));
+        }
+        TEST_ASSERT_EQUAL_UINT8(batch, queue.size());
+        uint16_t item;
+        while (queue.pop(item)) {
+            TEST_ASSERT_EQUAL_UINT16_MESSAGE(popped, item, "items come out in order, once each");
+            popped++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT16(pushed, popped);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.getDropped());
+}
+
+static void test_full_queue_drops_newest() {
+    SpscQueue<uint16_t, 64> queue;
+    for (uint16_t i = 0; i < 74; i++) {
+        TEST_ASSERT_EQUAL(i < 64, queue.push(i));
+    }
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(10, queue.getDropped(), "overflow is counted");
+    uint16_t item;
+    for (uint16_t i = 0; i < 64; i++) {
+        TEST_ASSERT_TRUE(queue.pop(item));
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(i, item, "older items are kept");
+    }
+    TEST_ASSERT_FALSE(queue.pop(item));
+}
+
+// ==================== REPLAY ====================
+static void test_recorded_stream_applies_every_step_once() {
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    app.begin();
+    driver.settle();
+
+    // Settings menu, edit "Work Duration" (row 0)
+    driver.tap(CENTER_X, SCREEN_HEIGHT - 20);
+    driver.shortPress();
+    TEST_ASSERT_EQUAL(STATE_SETTINGS, app.getState());
+    TEST_ASSERT_TRUE(app.isSettingsEditing());
+    TEST_ASSERT_EQUAL_UINT8(0, app.getSettingsMenuIndex());
+
+    uint32_t droppedBefore = platform->input.getDroppedSteps();
+    int32_t expectedMinutes = app.getSettings().workDuration / 60;
+    char message[64];
+    for (size_t r = 0; r < RUN_COUNT; r++) {
+        const DetentRun& run = RECORDING[r];
+        for (uint16_t i = 0; i < run.count; i++) {
+            platform->input.pushEncoderStep(run.step);
+            if (run.intervalMs) runLoop(app, run.intervalMs);
+        }
+        runLoop(app, run.pauseAfterMs);
+        expectedMinutes += run.count * run.step;
+
+        snprintf(message, sizeof(message), "work duration after run %u", (unsigned)r);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(expectedMinutes * 60, app.getSettings().workDuration, message);
+    }
+
+    int8_t step;
+    TEST_ASSERT_FALSE_MESSAGE(platform->input.popEncoderStep(step), "every queued step was consumed");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(droppedBefore, platform->input.getDroppedSteps(), "no step dropped");
+    TEST_ASSERT_EQUAL_UINT16(34 * 60, app.getSettings().workDuration);
+}
+
+int main() {
+    platform = &installHostHal();
+    UNITY_BEGIN();
+    RUN_TEST(test_queue_keeps_order_across_index_wrap);
+    RUN_TEST(test_full_queue_drops_newest);
+    RUN_TEST(test_recorded_stream_applies_every_step_once);
+    return UNITY_END();
+}
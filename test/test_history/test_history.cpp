@@ -0,0 +1,96 @@
+/**
+ * Session History Tests (pio test -e native -f test_history)
+ * Fails flash writes under the post() -> service() hand-off and checks that
+ * a session whose append fails stays queued and is logged on a later try,
+ * and that one the flash keeps refusing is counted as lost instead of
+ * blocking the queue. Tests run in order on the same log.
+ */
+
+#include <unity.h>
+#include "SessionHistory.h"
+#include "hal/host/HalHost.h"
+
+static const uint32_t WALL_CLOCK_BASE = 1700000000;
+
+static HostPlatform* platform;
+static SessionHistory* history;
+
+static HistoryEntry entryAt(uint32_t endTime, TimerState kind) {
+    HistoryEntry entry;
+    entry.endTime = endTime;
+    entry.duration = 25 * 60;
+    entry.kind = kind;
+    entry.wallClock = true;
+    return entry;
+}
+
+struct Collected {
+    uint32_t count;
+    uint32_t endTimes[8];
+};
+
+static void collect(const HistoryEntry& entry, void* context) {
+    Collected* collected = (Collected*)context;
+    if (collected->count < 8) collected->endTimes[collected->count] = entry.endTime;
+    collected->count++;
+}
+
+static Collected readBack() {
+    Collected collected = {};
+    SessionHistory::read(platform->history, collect, &collected);
+    return collected;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_failed_append_is_retried() {
+    TEST_ASSERT_TRUE(history->post(entryAt(WALL_CLOCK_BASE, STATE_RUNNING)));
+    history->service();
+    TEST_ASSERT_EQUAL_UINT32(1, readBack().count);
+
+    platform->history.failWrites(1);
+    TEST_ASSERT_TRUE(history->post(entryAt(WALL_CLOCK_BASE + 300, STATE_SHORT_BREAK)));
+    history->service();
+    TEST_ASSERT_TRUE_MESSAGE(history->isPending(), "a failed append stays queued");
+    TEST_ASSERT_EQUAL_UINT32(1, readBack().count);
+
+    history->service();
+    TEST_ASSERT_FALSE(history->isPending());
+    Collected collected = readBack();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, collected.count, "the retry logs the session");
+    TEST_ASSERT_EQUAL_UINT32(WALL_CLOCK_BASE + 300, collected.endTimes[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, history->getWriteFailures());
+    TEST_ASSERT_EQUAL_UINT32(0, history->getDropped());
+}
+
+static void test_failing_flash_drops_and_counts() {
+    platform->history.failWrites(UINT32_MAX);
+    TEST_ASSERT_TRUE(history->post(entryAt(WALL_CLOCK_BASE + 1800, STATE_RUNNING)));
+    TEST_ASSERT_TRUE(history->post(entryAt(WALL_CLOCK_BASE + 2100, STATE_SHORT_BREAK)));
+    for (uint8_t i = 0; i < 2 * HISTORY_APPEND_ATTEMPTS; i++) history->service();
+    TEST_ASSERT_FALSE_MESSAGE(history->isPending(), "a refused session doesn't block the queue");
+    TEST_ASSERT_EQUAL_UINT32(2, history->getDropped());
+    TEST_ASSERT_EQUAL_UINT32(1 + 2 * HISTORY_APPEND_ATTEMPTS, history->getWriteFailures());
+
+    // Once the flash takes writes again, logging carries on after the last good record
+    platform->history.failWrites(0);
+    TEST_ASSERT_TRUE(history->post(entryAt(WALL_CLOCK_BASE + 3600, STATE_RUNNING)));
+    history->service();
+    Collected collected = readBack();
+    TEST_ASSERT_EQUAL_UINT32(3, collected.count);
+    TEST_ASSERT_EQUAL_UINT32(WALL_CLOCK_BASE + 3600, collected.endTimes[2]);
+}
+
+int main() {
+    platform = &installHostHal();
+    platform->history.eraseAll();
+    SessionHistory log;
+    history = &log;
+    history->begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_failed_append_is_retried);
+    RUN_TEST(test_failing_flash_drops_and_counts);
+    return UNITY_END();
+}
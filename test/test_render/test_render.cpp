@@ -0,0 +1,242 @@
+/**
+ * Render Tests (pio test -e native -f test_render)
+ * Drives the app into every TimerState on the host panel and fails when a
+ * routine update (one second tick or one dial detent) pushes more pixels than
+ * its budget, or leaves drawn pixels unpushed (the panel must match the back
+ * buffer after every flush). Frames are not
+ * compared pixel for pixel: text and icons depend on the M5GFX build.
+ *   pio test -e native -f test_render -a <dir>       dump every frame as PPM
+ */
+
+#include <sys/stat.h>
+#include <unity.h>
+#include "App.h"
+#include "hal/host/AppDriver.h"
+#include "hal/host/HalHost.h"
+
+// ==================== SCENES ====================
+enum UpdateAction {
+    UPDATE_TICK,    // One second of virtual time
+    UPDATE_DIAL     // One encoder detent
+};
+
+// How a scene is entered when the app is already in its state
+enum SceneEntry {
+    ENTER_VIEW,     // Just look at it
+    ENTER_EDIT      // Settings: start editing the selected row
+};
+
+struct Scene {
+    const char* name;
+    uint8_t theme;              // Index into THEMES
+    TimerState state;
+    SceneEntry entry;
+    UpdateAction update;
+    int8_t dialStep;
+    uint32_t maxUpdatePixels;   // Panel pixels the update may push
+};
+
+// Routine updates should only repaint the digits or menu rows that changed
+static const uint32_t TIME_BOX_PIXELS = 160 * 45;
+static const uint32_t MENU_ROW_PIXELS = (SCREEN_WIDTH - 20) * 20;
+static const uint32_t MENU_VALUE_PIXELS = MENU_ROW_PIXELS / 4;    // "MM:SS" field of a row
+
+// Entered in this order by one app instance (each scene continues from the last)
+static const Scene SCENES[] = {
+    { "ready",          0, STATE_IDLE,        ENTER_VIEW, UPDATE_DIAL, -1, TIME_BOX_PIXELS },
+    { "focusing",       0, STATE_RUNNING,     ENTER_VIEW, UPDATE_TICK,  0, TIME_BOX_PIXELS },
+    { "paused",         0, STATE_PAUSED,      ENTER_VIEW, UPDATE_TICK,  0, 0 },
+    { "short_break",    0, STATE_SHORT_BREAK, ENTER_VIEW, UPDATE_TICK,  0, TIME_BOX_PIXELS },
+    { "long_break",     0, STATE_LONG_BREAK,  ENTER_VIEW, UPDATE_TICK,  0, TIME_BOX_PIXELS },
+    { "stats",          0, STATE_STATS,       ENTER_VIEW, UPDATE_TICK,  0, 0 },
+    // Navigating repaints the old and new highlighted rows, editing the value field only
+    { "settings",       0, STATE_SETTINGS,    ENTER_VIEW, UPDATE_DIAL,  1, 2 * MENU_ROW_PIXELS },
+    { "settings_edit",  0, STATE_SETTINGS,    ENTER_EDIT, UPDATE_DIAL,  1, MENU_VALUE_PIXELS },
+    { "midnight_ready", 1, STATE_IDLE,        ENTER_VIEW, UPDATE_DIAL, -1, TIME_BOX_PIXELS },
+    { "midnight_focus", 1, STATE_RUNNING,     ENTER_VIEW, UPDATE_TICK,  0, TIME_BOX_PIXELS },
+};
+static const size_t SCENE_COUNT = sizeof(SCENES) / sizeof(SCENES[0]);
+
+static const uint32_t SIMULATION_LIMIT_MS = 24UL * 60UL * 60UL * 1000UL;
+
+// What one pass over the scenes found (the tests below assert on it)
+struct SceneResult {
+    bool reached;
+    bool dumped;                // Frame written to the output dir (if any)
+    uint32_t updatePixels;      // Pixels pushed by the update
+    uint32_t changedPixels;     // Panel pixels the update changed
+    uint32_t unpushedPixels;    // Back buffer pixels missing from the panel afterwards
+};
+
+static HostPlatform* platform;
+static const char* outDir = nullptr;
+static SceneResult results[SCENE_COUNT];
+
+// ==================== DRIVING THE APP ====================
+// Pick a theme from the settings menu ("Theme" is row 5, "Back" row 6); ends on Ready
+static bool selectTheme(PomodoroApp& app, AppDriver& driver, uint8_t theme) {
+    if (app.isSettingsEditing()) driver.shortPress();
+    if (app.getState() == STATE_STATS) driver.shortPress();
+    else if (app.getState() != STATE_IDLE && app.getState() != STATE_SETTINGS) driver.longPress();
+    if (app.getState() != STATE_SETTINGS) driver.tap(CENTER_X, SCREEN_HEIGHT - 20);
+    driver.turnDial(5 - (int8_t)app.getSettingsMenuIndex());
+    driver.shortPress();
+    driver.turnDial((int8_t)theme - (int8_t)app.getSettings().themeIndex);
+    driver.shortPress();
+    driver.turnDial(1);
+    driver.shortPress();
+    return app.getState() == STATE_IDLE && app.getSettings().themeIndex == theme;
+}
+
+// Script the input that leads from the previous scene into this one
+static bool enterScene(PomodoroApp& app, AppDriver& driver, TimerState state, SceneEntry entry) {
+    if (entry == ENTER_EDIT) {
+        if (app.getState() != state) return false;
+        driver.shortPress();
+        return app.isSettingsEditing();
+    }
+    switch (state) {
+        case STATE_IDLE:
+            driver.settle();
+            break;
+        case STATE_RUNNING:
+        case STATE_PAUSED:
+            driver.shortPress();
+            break;
+        case STATE_SHORT_BREAK:
+        case STATE_LONG_BREAK:
+            if (app.getState() == STATE_PAUSED) driver.shortPress();
+            return driver.runUntil(state, SIMULATION_LIMIT_MS);
+        case STATE_SETTINGS:
+            if (app.getState() == STATE_STATS) driver.shortPress();
+            else if (app.getState() != STATE_IDLE) driver.longPress();
+            driver.tap(CENTER_X, SCREEN_HEIGHT - 20); // Gear icon
+            break;
+        case STATE_STATS:
+            if (app.getState() != STATE_IDLE) driver.longPress();
+            driver.tap(CENTER_X, 20); // Pomodoro counter
+            break;
+    }
+    return app.getState() == state;
+}
+
+// ==================== FRAMES ====================
+static uint32_t countChangedPixels(const uint8_t* a, const uint8_t* b) {
+    uint32_t changed = 0;
+    for (size_t i = 0; i < HostDisplay::FRAME_BYTES; i += 3) {
+        if (a[i] != b[i] || a[i + 1] != b[i + 1] || a[i + 2] != b[i + 2]) changed++;
+    }
+    return changed;
+}
+
+// Pixels drawn into the back buffer but not (yet) on the panel
+static uint32_t countUnpushedPixels(Display& display) {
+    if (!display.isBuffered()) return 0;
+    LovyanGFX& canvas = display.gfx();
+    LovyanGFX& panel = platform->display.panel();
+    uint32_t unpushed = 0;
+    for (int16_t y = 0; y < SCREEN_HEIGHT; y++) {
+        for (int16_t x = 0; x < SCREEN_WIDTH; x++) {
+            if (canvas.readPixel(x, y) != panel.readPixel(x, y)) unpushed++;
+        }
+    }
+    return unpushed;
+}
+
+// One app instance walks every scene in order, recording what each test checks
+static void renderScenes() {
+    if (outDir) mkdir(outDir, 0755);
+
+    static uint8_t frame[HostDisplay::FRAME_BYTES];
+    static uint8_t updated[HostDisplay::FRAME_BYTES];
+
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    app.begin();
+    Display& display = app.getDisplay();
+
+    char path[256];
+    for (size_t i = 0; i < SCENE_COUNT; i++) {
+        const Scene& scene = SCENES[i];
+        SceneResult& result = results[i];
+        result = SceneResult{ false, true, 0, 0, 0 };
+
+        if (app.getSettings().themeIndex != scene.theme && !selectTheme(app, driver, scene.theme)) {
+            printf("%-14s could not select theme %s\n", scene.name, THEMES[scene.theme].name);
+            continue;
+        }
+        uint32_t bytesBefore = display.getBytesPushed();
+        if (!enterScene(app, driver, scene.state, scene.entry)) {
+            printf("%-14s could not reach state\n", scene.name);
+            continue;
+        }
+        result.reached = true;
+        uint32_t enterPixels = (display.getBytesPushed() - bytesBefore) / 2;
+        platform->display.capture(frame);
+
+        if (outDir) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", outDir, scene.name);
+            result.dumped = platform->display.writePpm(path);
+        }
+
+        // Cost of a routine update on this screen
+        bytesBefore = display.getBytesPushed();
+        if (scene.update == UPDATE_DIAL) {
+            driver.turnDial(scene.dialStep);
+        } else {
+            driver.runFor(1000);
+        }
+        result.updatePixels = (display.getBytesPushed() - bytesBefore) / 2;
+        platform->display.capture(updated);
+        result.changedPixels = countChangedPixels(frame, updated);
+        result.unpushedPixels = countUnpushedPixels(display);
+
+        printf("%-14s enter %6lu px | %s %5lu px written (%5lu SPI bytes), %5lu changed (budget %lu)\n",
+               scene.name, (unsigned long)enterPixels,
+               scene.update == UPDATE_DIAL ? "dial" : "tick",
+               (unsigned long)result.updatePixels, (unsigned long)result.updatePixels * 2,
+               (unsigned long)result.changedPixels, (unsigned long)scene.maxUpdatePixels);
+    }
+}
+
+// ==================== TESTS ====================
+void setUp() {}
+void tearDown() {}
+
+static void test_every_scene_is_reached() {
+    for (size_t i = 0; i < SCENE_COUNT; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(results[i].reached, SCENES[i].name);
+        TEST_ASSERT_TRUE_MESSAGE(results[i].dumped, SCENES[i].name);
+    }
+}
+
+// The dirty region covered everything the update drew
+static void test_updates_push_what_they_draw() {
+    char message[64];
+    for (size_t i = 0; i < SCENE_COUNT; i++) {
+        if (!results[i].reached) continue;
+        snprintf(message, sizeof(message), "%s: drawn pixels left off the panel", SCENES[i].name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, results[i].unpushedPixels, message);
+    }
+}
+
+static void test_updates_fit_their_budgets() {
+    char message[64];
+    for (size_t i = 0; i < SCENE_COUNT; i++) {
+        if (!results[i].reached) continue;
+        snprintf(message, sizeof(message), "%s: pixels pushed by one update", SCENES[i].name);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(SCENES[i].maxUpdatePixels, results[i].updatePixels, message);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) outDir = argv[1];
+    platform = &installHostHal();
+    renderScenes();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_every_scene_is_reached);
+    RUN_TEST(test_updates_push_what_they_draw);
+    RUN_TEST(test_updates_fit_their_budgets);
+    return UNITY_END();
+}
@@ -0,0 +1,344 @@
+/**
+ * Session Resume Tests (pio test -e native -f test_resume)
+ * Interrupts sessions with warm resets and power loss (with and without a
+ * wall clock, with an unset RTC, and mid-append) and checks that each one
+ * comes back in the right state with the right remaining time. Then runs
+ * hours of cycles and checks that checkpointing stays within its write rate
+ * and cost budget.
+ * Tests run in order: each one continues the previous one's session.
+ */
+
+#include <chrono>
+#include <unity.h>
+#include "App.h"
+#include "hal/host/AppDriver.h"
+#include "hal/host/HalHost.h"
+
+static const uint32_t WALL_CLOCK_BASE = 1700000000;   // Any epoch after WALL_CLOCK_MIN_VALID
+static const uint32_t RTC_RESET_TIME = 946684800;     // 2000-01-01, the BM8563 default after losing power
+static const uint32_t HOUR_MS = 60UL * 60UL * 1000UL;
+
+static HostPlatform* platform;
+
+// Carried from one test to the next
+static uint32_t remainingBefore;
+static TimerState stateBefore;
+
+static bool near(uint32_t actual, uint32_t expected, uint32_t tolerance) {
+    return actual + tolerance >= expected && actual <= expected + tolerance;
+}
+
+// A fresh app on the same HAL is a reboot; offMs passes before it starts
+enum ResetKind {
+    RESET_WARM,         // RTC memory kept (brownout, watchdog)
+    RESET_POWER_LOSS    // RTC memory lost, only the flash journal survives
+};
+
+struct Session {
+    PomodoroApp app;
+    AppDriver driver;
+    explicit Session(HostPlatform& platform) : app(), driver(app, platform) {}
+};
+
+static void boot(Session& s) {
+    s.app.begin();
+    s.driver.settle();
+}
+
+static void interrupt(ResetKind kind, uint32_t offMs) {
+    if (kind == RESET_POWER_LOSS) platform->retained.scramble();
+    platform->clock.advanceMs(offMs);
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ==================== WARM RESET ====================
+static void test_warm_reset_resumes() {
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_IDLE, s.app.getState(), "blank checkpoint storage boots to Ready");
+        s.driver.shortPress();
+        s.driver.runFor(10UL * 60UL * 1000UL + 500);
+        remainingBefore = s.app.getTimerManager().getRemaining();
+    }
+    interrupt(RESET_WARM, 2000);
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_RUNNING, s.app.getState(), "warm reset resumes Focusing");
+        TEST_ASSERT_TRUE_MESSAGE(near(s.app.getTimerManager().getRemaining(), remainingBefore - 2, 1),
+                                 "warm reset: remaining time counts the 2 s reset");
+        s.driver.runFor(5UL * 60UL * 1000UL);
+        remainingBefore = s.app.getTimerManager().getRemaining();
+    }
+}
+
+// ==================== POWER LOSS ====================
+static void test_power_loss_resumes_from_journal() {
+    interrupt(RESET_POWER_LOSS, 30000);
+    Session s(*platform);
+    boot(s);
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_RUNNING, s.app.getState(), "power loss resumes Focusing from the journal");
+    TEST_ASSERT_TRUE_MESSAGE(near(s.app.getTimerManager().getRemaining(), remainingBefore - 30, 1),
+                             "power loss: wall clock accounts for the 30 s off");
+    remainingBefore = s.app.getTimerManager().getRemaining();
+}
+
+// Without a wall clock the downtime is unknown: resume paused, at most a minute back
+static void test_power_loss_without_wall_clock_resumes_paused() {
+    platform->clock.setWallBase(0);
+    interrupt(RESET_POWER_LOSS, 30000);
+    {
+        Session s(*platform);
+        boot(s);
+        uint32_t remaining = s.app.getTimerManager().getRemaining();
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_PAUSED, s.app.getState(), "no wall clock: session comes back paused");
+        TEST_ASSERT_TRUE_MESSAGE(remaining >= remainingBefore && remaining <= remainingBefore + 60,
+                                 "no wall clock: remaining time from the last journal record");
+        s.driver.shortPress();
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_RUNNING, s.app.getState(), "resumed-paused session continues as Focusing");
+        s.driver.shortPress();
+        remainingBefore = s.app.getTimerManager().getRemaining();
+    }
+    platform->clock.setWallBase(WALL_CLOCK_BASE);
+}
+
+// The RTC lost its time during the session and was set again while powered off:
+// the checkpoint's wall time is invalid, so the downtime is unknown
+static void test_power_loss_with_unset_rtc_resumes_paused() {
+    platform->clock.setWallBase(RTC_RESET_TIME);
+    {
+        Session s(*platform);
+        boot(s);
+        s.driver.shortPress();
+        TEST_ASSERT_EQUAL(STATE_RUNNING, s.app.getState());
+        remainingBefore = s.app.getTimerManager().getRemaining();
+        s.driver.runFor(5000);
+    }
+    interrupt(RESET_POWER_LOSS, 30000);
+    platform->clock.setWallBase(WALL_CLOCK_BASE);
+    {
+        Session s(*platform);
+        boot(s);
+        uint32_t remaining = s.app.getTimerManager().getRemaining();
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_PAUSED, s.app.getState(), "unset RTC: session comes back paused");
+        TEST_ASSERT_TRUE_MESSAGE(remaining + 60 >= remainingBefore && remaining <= remainingBefore,
+                                 "unset RTC: remaining time from the last journal record");
+        s.driver.shortPress();
+        s.driver.shortPress();
+        remainingBefore = s.app.getTimerManager().getRemaining();
+    }
+}
+
+// A paused session stays paused with its remaining time, however long it was off
+static void test_paused_session_stays_paused() {
+    interrupt(RESET_POWER_LOSS, 10UL * 60UL * 1000UL);
+    Session s(*platform);
+    boot(s);
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_PAUSED, s.app.getState(), "paused session stays paused");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(remainingBefore, s.app.getTimerManager().getRemaining(),
+                                     "paused remaining time unchanged");
+    s.driver.shortPress();
+}
+
+// ==================== TORN APPEND ====================
+// Power fails half-way through the append for the next state change
+static void test_torn_append_uses_previous_record() {
+    {
+        Session s(*platform);
+        boot(s);
+        remainingBefore = s.app.getTimerManager().getRemaining();
+        platform->journal.tearNextWrite(12);
+        s.driver.shortPress();  // Pause: RTC and journal checkpoint
+    }
+    interrupt(RESET_POWER_LOSS, 1000);
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_RUNNING, s.app.getState(), "torn append: previous journal record used");
+        TEST_ASSERT_TRUE_MESSAGE(near(s.app.getTimerManager().getRemaining(), remainingBefore - 1, 1),
+                                 "torn append: remaining time from the previous record");
+        s.driver.shortPress();
+        s.driver.runFor(1000);
+        s.driver.shortPress();  // Appends after the torn slot must still land and be found
+    }
+    interrupt(RESET_POWER_LOSS, 1000);
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_RUNNING, s.app.getState(), "journal keeps working after a torn append");
+    }
+}
+
+// ==================== CYCLE POSITION ====================
+static void test_cycle_position_survives_reset() {
+    {
+        Session s(*platform);
+        boot(s);
+        s.driver.runUntil(STATE_SHORT_BREAK, platform->clock.millis() + HOUR_MS);
+        s.driver.runFor(60000);
+    }
+    interrupt(RESET_WARM, 1000);
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_SHORT_BREAK, s.app.getState(), "break resumes as a break");
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(1, s.app.getCompletedPomodoros(), "completed pomodoros survive a reset");
+        s.driver.longPress();
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_IDLE, s.app.getState(), "long press resets to Ready");
+    }
+    interrupt(RESET_POWER_LOSS, 1000);
+    {
+        Session s(*platform);
+        boot(s);
+        TEST_ASSERT_EQUAL_MESSAGE(STATE_IDLE, s.app.getState(), "reset session is not resumed");
+        s.driver.shortPress();
+        s.driver.runFor(60000);
+    }
+}
+
+// Too long off: the session is dropped
+static void test_long_downtime_drops_session() {
+    interrupt(RESET_POWER_LOSS, (RESUME_MAX_DOWNTIME_S + 60) * 1000UL);
+    Session s(*platform);
+    boot(s);
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_IDLE, s.app.getState(), "session interrupted for over 30 min is dropped");
+}
+
+// ==================== COST ====================
+// Ten hours of cycles: write rates, ring wrap-around, then one more power loss
+static void test_checkpoint_write_rates() {
+    Session s(*platform);
+    boot(s);
+    uint32_t flashWritesBefore = platform->journal.getWriteCount();
+    uint32_t erasesBefore = platform->journal.getEraseCount();
+    SessionCheckpoint& checkpoint = s.app.getCheckpoint();
+    checkpoint.resetStats();
+
+    uint32_t end = platform->clock.millis() + 10 * HOUR_MS;
+    while (platform->clock.millis() < end) {
+        if (s.app.getState() == STATE_IDLE) s.driver.shortPress();
+        s.driver.step();
+    }
+    double countingS = checkpoint.getCountingMs() / 1000.0;
+    uint32_t rtcWrites = checkpoint.getRtcWrites();
+    uint32_t flashWrites = platform->journal.getWriteCount() - flashWritesBefore;
+    uint32_t erases = platform->journal.getEraseCount() - erasesBefore;
+    printf("Counting %.0f s: %lu RTC writes (%.3f/s), %lu journal appends (%.1f/h), %lu sector erases\n",
+           countingS, (unsigned long)rtcWrites, rtcWrites / countingS, (unsigned long)flashWrites,
+           flashWrites / (countingS / 3600.0), (unsigned long)erases);
+    TEST_ASSERT_TRUE_MESSAGE(rtcWrites <= countingS * 1.02, "RTC memory written at most once per counted second");
+    TEST_ASSERT_TRUE_MESSAGE(flashWrites / (countingS / 3600.0) <= 60 + 12, "journal appends stay near one per minute");
+    TEST_ASSERT_TRUE_MESSAGE(erases >= 1, "journal ring wrapped");
+
+    if (s.app.getState() == STATE_IDLE) s.driver.shortPress();
+    s.driver.runFor(90000);
+    stateBefore = s.app.getState();
+    remainingBefore = s.app.getTimerManager().getRemaining();
+}
+
+// Host cost of one counted second of checkpointing (RTC every call, journal every
+// 60th), on scratch storage so the app's checkpoints stay intact
+static void test_checkpoint_cost_within_budget() {
+    HostRetainedMemory scratchRetained;
+    HostFlash scratchJournal(platform->journal.size());
+    HalRetainedMemory* retained = hal.retained;
+    HalFlash* journal = hal.journal;
+    hal.retained = &scratchRetained;
+    hal.journal = &scratchJournal;
+    SessionCheckpoint bench;
+    SessionSnapshot benchSession;
+    uint32_t benchDowntime;
+    bench.begin(benchSession, benchDowntime);
+    memset(&benchSession, 0, sizeof(benchSession));
+    benchSession.state = STATE_RUNNING;
+    benchSession.duration = 3600;
+    const uint32_t seconds = 100000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < seconds; i++) {
+        benchSession.elapsedMs = (i % 3600) * 1000;
+        benchSession.completedPomodoros = (uint8_t)(i / 3600);
+        bench.update(benchSession);
+        bench.service();
+    }
+    double nsPerSecond = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start).count() / seconds;
+    hal.retained = retained;
+    hal.journal = journal;
+    printf("Checkpoint cost on host: %.0f ns per counted second (budget %lu us)\n",
+           nsPerSecond, (unsigned long)CHECKPOINT_BUDGET_US_PER_S);
+    TEST_ASSERT_TRUE_MESSAGE(nsPerSecond < CHECKPOINT_BUDGET_US_PER_S * 1000.0, "checkpoint cost within budget");
+}
+
+// The control loop only queues journal appends; service() makes them, and a
+// newer checkpoint replaces one still waiting
+static void test_journal_append_waits_for_service() {
+    HostRetainedMemory scratchRetained;
+    HostFlash scratchJournal(platform->journal.size());
+    HalRetainedMemory* retained = hal.retained;
+    HalFlash* journal = hal.journal;
+    hal.retained = &scratchRetained;
+    hal.journal = &scratchJournal;
+    SessionCheckpoint checkpoint;
+    SessionSnapshot session;
+    uint32_t downtime;
+    checkpoint.begin(session, downtime);
+    memset(&session, 0, sizeof(session));
+    session.state = STATE_RUNNING;
+    session.duration = 1500;
+
+    TEST_ASSERT_TRUE_MESSAGE(checkpoint.update(session), "state change queues a journal append");
+    session.state = STATE_PAUSED;
+    TEST_ASSERT_TRUE_MESSAGE(checkpoint.update(session), "second state change queues another");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, scratchJournal.getWriteCount(), "update() leaves the flash alone");
+    TEST_ASSERT_TRUE(checkpoint.isJournalPending());
+
+    checkpoint.service();
+    TEST_ASSERT_FALSE(checkpoint.isJournalPending());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, scratchJournal.getWriteCount(), "only the newest record is written");
+    TEST_ASSERT_EQUAL_UINT32(1, checkpoint.getFlashErases());
+    checkpoint.service();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, scratchJournal.getWriteCount(), "nothing queued, nothing written");
+
+    // A reset request from the control side is carried out by service()
+    checkpoint.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(1, checkpoint.getFlashErases());
+    checkpoint.service();
+    TEST_ASSERT_EQUAL_UINT32(0, checkpoint.getFlashErases());
+
+    hal.retained = retained;
+    hal.journal = journal;
+}
+
+static void test_resume_after_journal_wrapped() {
+    interrupt(RESET_POWER_LOSS, 5000);
+    Session s(*platform);
+    boot(s);
+    TEST_ASSERT_EQUAL_MESSAGE(stateBefore, s.app.getState(), "resume after the journal wrapped");
+    TEST_ASSERT_TRUE_MESSAGE(near(s.app.getTimerManager().getRemaining(), remainingBefore - 5, 1),
+                             "remaining time after the journal wrapped");
+}
+
+int main() {
+    platform = &installHostHal();
+    platform->clock.setWallBase(WALL_CLOCK_BASE);
+    platform->retained.scramble();
+    platform->journal.eraseAll();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_warm_reset_resumes);
+    RUN_TEST(test_power_loss_resumes_from_journal);
+    RUN_TEST(test_power_loss_without_wall_clock_resumes_paused);
+    RUN_TEST(test_power_loss_with_unset_rtc_resumes_paused);
+    RUN_TEST(test_paused_session_stays_paused);
+    RUN_TEST(test_torn_append_uses_previous_record);
+    RUN_TEST(test_cycle_position_survives_reset);
+    RUN_TEST(test_long_downtime_drops_session);
+    RUN_TEST(test_checkpoint_write_rates);
+    RUN_TEST(test_checkpoint_cost_within_budget);
+    RUN_TEST(test_journal_append_waits_for_service);
+    RUN_TEST(test_resume_after_journal_wrapped);
+    return UNITY_END();
+}
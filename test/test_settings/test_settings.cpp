@@ -0,0 +1,227 @@
+/**
+ * Settings Persistence Tests (pio test -e native -f test_settings)
+ * Runs the app against the host's fake NVS: settings survive a reboot, a dial
+ * spin is coalesced into one write after the quiet period, dialing back to the
+ * stored values writes nothing, corrupt or foreign records fall back to the
+ * defaults and records from the previous schema are migrated. Tests run in order and share the NVS, like reboots of one device.
+ */
+
+#include <unity.h>
+#include "App.h"
+#include "Crc32.h"
+#include "hal/host/AppDriver.h"
+#include "hal/host/HalHost.h"
+
+static HostPlatform* platform;
+
+// A fresh app instance on the same storage is a reboot
+static void boot(PomodoroApp& app, AppDriver& driver) {
+    app.begin();
+    driver.settle();
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ==================== FIRST BOOT ====================
+static void test_first_boot_coalesces_dial_writes() {
+    HostStorage& storage = platform->storage;
+    storage.erase();
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    uint16_t defaultWork = app.getSettings().workDuration;
+    boot(app, driver);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(defaultWork, app.getSettings().workDuration, "empty storage boots with defaults");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, storage.getWriteCount(), "booting writes nothing");
+
+    // Twenty detents in quick succession, one loop apart
+    for (uint8_t i = 0; i < 20; i++) {
+        driver.turnDial(-1);
+    }
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, storage.getWriteCount(), "no write while the dial is still moving");
+    TEST_ASSERT_TRUE_MESSAGE(app.getSettingsStore().isDirty(), "change is pending");
+
+    driver.runFor(SETTINGS_COMMIT_DELAY_MS + 100);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, storage.getWriteCount(), "20 detents coalesce into one write");
+    TEST_ASSERT_FALSE_MESSAGE(app.getSettingsStore().isDirty(), "nothing pending after the commit");
+
+    // Away and back again inside the quiet period
+    driver.turnDial(2);
+    driver.turnDial(-2);
+    driver.runFor(SETTINGS_COMMIT_DELAY_MS + 100);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, storage.getWriteCount(), "dialing back to the stored value writes nothing");
+}
+
+// ==================== REBOOT ====================
+static void test_dialed_duration_survives_reboot() {
+    HostStorage& storage = platform->storage;
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    boot(app, driver);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(5 * 60, app.getSettings().workDuration, "dialed duration survives a reboot");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, app.getSettingsStore().getWriteCount(), "write count survives a reboot");
+
+    // Settings menu: brightness (row 4) up one, the next theme (row 5), then Back
+    driver.tap(CENTER_X, SCREEN_HEIGHT - 20);
+    driver.turnDial(4);
+    driver.shortPress();
+    driver.turnDial(1);
+    driver.shortPress();
+    driver.turnDial(1);
+    driver.shortPress();
+    driver.turnDial(1);
+    driver.shortPress();
+    driver.turnDial(1);
+    driver.shortPress();
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_IDLE, app.getState(), "Back leaves the menu");
+    driver.runFor(SETTINGS_COMMIT_DELAY_MS + 100);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(2, storage.getWriteCount(), "menu edit commits once");
+}
+
+static void test_menu_edit_survives_reboot() {
+    HostStorage& storage = platform->storage;
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    boot(app, driver);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(4, app.getSettings().brightnessLevel, "menu edit survives a reboot");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE((4 * 255) / 6, platform->display.getBrightness(), "stored brightness applied at boot");
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(1, app.getSettings().themeIndex, "theme survives a reboot");
+    TEST_ASSERT_TRUE_MESSAGE(&app.getDisplay().getTheme() == &THEMES[1], "stored theme applied at boot");
+
+    // Pending change flushed before a planned reboot
+    driver.turnDial(1);
+    app.getSettingsStore().flush();
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(3, storage.getWriteCount(), "flush writes a pending change immediately");
+}
+
+// ==================== CORRUPTION ====================
+static void test_crc_mismatch_falls_back_to_defaults() {
+    platform->storage.corrupt("settings", 4);
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    uint16_t defaultWork = app.getSettings().workDuration;
+    boot(app, driver);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(defaultWork, app.getSettings().workDuration, "CRC mismatch falls back to defaults");
+}
+
+static void test_foreign_record_is_ignored() {
+    HostStorage& storage = platform->storage;
+    storage.erase();
+    uint8_t foreign[6] = { 1, 2, 3, 4, 5, 6 };
+    storage.save("settings", foreign, sizeof(foreign));
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    uint16_t defaultWork = app.getSettings().workDuration;
+    boot(app, driver);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(defaultWork, app.getSettings().workDuration, "record of another size is ignored");
+}
+
+// ==================== MIGRATION ====================
+// Settings saved before themes (schema 1) carry over with the default theme
+static void test_v1_record_is_migrated() {
+    struct RecordV1 {
+        uint16_t version;
+        uint16_t size;
+        uint16_t workDuration;
+        uint16_t shortBreakDuration;
+        uint16_t longBreakDuration;
+        uint8_t pomodorosUntilLongBreak;
+        uint8_t brightnessLevel;
+        uint32_t writeCount;
+        uint32_t crc;
+    } v1 = { 1, sizeof(RecordV1), 20 * 60, 7 * 60, 30 * 60, 3, 5, 12, 0 };
+    v1.crc = crc32(&v1, offsetof(RecordV1, crc));
+    HostStorage& storage = platform->storage;
+    storage.erase();
+    storage.save("settings", &v1, sizeof(v1));
+    uint32_t writesBefore = storage.getWriteCount();
+
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    boot(app, driver);
+    const PomodoroSettings& settings = app.getSettings();
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(20 * 60, settings.workDuration, "v1 work duration kept");
+    TEST_ASSERT_EQUAL_UINT16(7 * 60, settings.shortBreakDuration);
+    TEST_ASSERT_EQUAL_UINT16(30 * 60, settings.longBreakDuration);
+    TEST_ASSERT_EQUAL_UINT8(3, settings.pomodorosUntilLongBreak);
+    TEST_ASSERT_EQUAL_UINT8(5, settings.brightnessLevel);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(0, settings.themeIndex, "v1 record gets the default theme");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(12, app.getSettingsStore().getWriteCount(), "wear count carries over");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(writesBefore, storage.getWriteCount(), "migrating writes nothing");
+
+    // The next change is written in the current layout
+    driver.turnDial(1);
+    app.getSettingsStore().flush();
+    PomodoroApp rebooted;
+    AppDriver rebootedDriver(rebooted, *platform);
+    boot(rebooted, rebootedDriver);
+    TEST_ASSERT_EQUAL_UINT16_MESSAGE(21 * 60, rebooted.getSettings().workDuration, "upgraded record loads");
+    TEST_ASSERT_EQUAL_UINT32(13, rebooted.getSettingsStore().getWriteCount());
+}
+
+// ==================== PADDING ====================
+// Settings equal field by field are the same settings, whatever the padding holds
+static void test_padding_is_not_a_change() {
+    PomodoroSettings stored;
+    PomodoroSettings same;
+    memset(&stored, 0xA5, sizeof(stored));
+    memset(&same, 0x5A, sizeof(same));
+    stored.workDuration = same.workDuration = 20 * 60;
+    stored.shortBreakDuration = same.shortBreakDuration = 5 * 60;
+    stored.longBreakDuration = same.longBreakDuration = 15 * 60;
+    stored.pomodorosUntilLongBreak = same.pomodorosUntilLongBreak = 4;
+    stored.brightnessLevel = same.brightnessLevel = 3;
+    stored.themeIndex = same.themeIndex = 0;
+
+    platform->storage.erase();
+    SettingsStore store;
+    store.load(stored);
+    store.update(same);
+    TEST_ASSERT_FALSE_MESSAGE(store.isDirty(), "padding-only difference is not a change");
+
+    // Written from a copy with garbage padding, the record still loads
+    same.brightnessLevel = 4;
+    store.update(same);
+    store.flush();
+    PomodoroSettings loaded;
+    memset(&loaded, 0xFF, sizeof(loaded));
+    loaded.themeIndex = 0;
+    TEST_ASSERT_TRUE_MESSAGE(SettingsStore().load(loaded), "stored record loads back");
+    TEST_ASSERT_EQUAL_UINT8(4, loaded.brightnessLevel);
+}
+
+// ==================== WEAR ====================
+static void test_hour_of_dialing_is_one_write() {
+    HostStorage& storage = platform->storage;
+    storage.erase();
+    PomodoroApp app;
+    AppDriver driver(app, *platform);
+    boot(app, driver);
+    uint32_t writesBefore = storage.getWriteCount();
+    // An hour of fiddling: one detent every 500 ms
+    for (uint16_t i = 0; i < 7200; i++) {
+        driver.turnDial((i / 10) % 2 ? -1 : 1);
+        driver.runFor(500);
+    }
+    driver.runFor(SETTINGS_COMMIT_DELAY_MS + 100);
+    uint32_t writes = storage.getWriteCount() - writesBefore;
+    printf("Wear: 7200 detents -> %lu writes, %lu writes total, ~%lu NVS erase cycles\n",
+           (unsigned long)writes, (unsigned long)app.getSettingsStore().getWriteCount(),
+           (unsigned long)app.getSettingsStore().getEstimatedEraseCycles());
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1, writes, "an hour of continuous dialing is one write");
+}
+
+int main() {
+    platform = &installHostHal();
+    UNITY_BEGIN();
+    RUN_TEST(test_first_boot_coalesces_dial_writes);
+    RUN_TEST(test_dialed_duration_survives_reboot);
+    RUN_TEST(test_menu_edit_survives_reboot);
+    RUN_TEST(test_crc_mismatch_falls_back_to_defaults);
+    RUN_TEST(test_foreign_record_is_ignored);
+    RUN_TEST(test_v1_record_is_migrated);
+    RUN_TEST(test_padding_is_not_a_change);
+    RUN_TEST(test_hour_of_dialing_is_one_write);
+    platform->storage.erase();
+    return UNITY_END();
+}
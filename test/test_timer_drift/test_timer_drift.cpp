@@ -0,0 +1,154 @@
+/**
+ * Timer Drift Tests (pio test -e native -f test_timer_drift)
+ * Random pause/resume sequences on a fresh host clock (so sessions start at
+ * time 0): elapsed time must equal the sum of the running segments to the
+ * microsecond, however many segments it is split into. Sessions started,
+ * restored or completed at time 0 must behave like any others.
+ */
+
+#include <unity.h>
+#include "TimerManager.h"
+#include "hal/host/HalHost.h"
+
+static const uint32_t SEQUENCES = 2000;
+static const uint32_t OPERATIONS = 200;         // Pause/resume toggles per sequence
+static const uint32_t MAX_GAP_US = 5000000;     // Up to 5 s between toggles
+static const uint32_t SESSION_S = 24 * 60 * 60; // Long enough never to complete here
+
+// Deterministic xorshift so a failure can be replayed
+static uint32_t rngState;
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct Session {
+    HostClock clock;            // Starts at 0
+    TimerManager timer;
+    TimerState state;
+    PomodoroSettings settings;
+    uint8_t completedPomodoros;
+    bool needsRedraw;
+
+    Session() : clock(), timer(), state(STATE_IDLE), completedPomodoros(0), needsRedraw(false) {
+        hal.clock = &clock;
+        settings.workDuration = 25 * 60;
+        settings.shortBreakDuration = 5 * 60;
+        settings.longBreakDuration = 25 * 60;
+        settings.pomodorosUntilLongBreak = 4;
+        settings.brightnessLevel = 3;
+        settings.themeIndex = 0;
+    }
+
+    void update() { timer.update(state, settings, completedPomodoros, needsRedraw); }
+};
+
+void setUp() {
+    rngState = 0x9E3779B9;
+}
+
+void tearDown() {
+    installHostHal();   // Put the shared clock back
+}
+
+// A session started when the clock reads 0 is running, not paused
+static void test_session_started_at_clock_zero_runs() {
+    Session s;
+    s.timer.start(SESSION_S, s.state);
+    s.clock.advanceUs(1500000);
+    TEST_ASSERT_EQUAL_UINT64(1500000, s.timer.getElapsedUs());
+
+    s.timer.pause(s.state);
+    TEST_ASSERT_EQUAL(STATE_PAUSED, s.state);
+    TEST_ASSERT_EQUAL_UINT64_MESSAGE(1500000, s.timer.getElapsedUs(), "pause banks the segment started at 0");
+    s.clock.advanceUs(700000);
+    TEST_ASSERT_EQUAL_UINT64_MESSAGE(1500000, s.timer.getElapsedUs(), "nothing counts while paused");
+}
+
+// Resumed at clock 0 after a reset: the restored session keeps counting
+static void test_session_restored_at_clock_zero_runs() {
+    Session s;
+    SessionSnapshot session = {};
+    session.state = STATE_RUNNING;
+    session.stateBeforePause = STATE_RUNNING;
+    session.duration = SESSION_S;
+    session.elapsedMs = 90000;
+    s.timer.restoreSession(session, 0, s.state);
+    s.clock.advanceUs(250000);
+    TEST_ASSERT_EQUAL_UINT64(90250000, s.timer.getElapsedUs());
+
+    session.state = STATE_PAUSED;
+    Session paused;
+    paused.timer.restoreSession(session, 5000, paused.state);
+    paused.clock.advanceUs(250000);
+    TEST_ASSERT_EQUAL_UINT64_MESSAGE(90000000, paused.timer.getElapsedUs(), "paused session restores paused");
+}
+
+// A session that completes when the clock reads 0 still sounds its alarm and moves on
+static void test_session_completed_at_clock_zero_alarms() {
+    Session s;
+    SessionSnapshot session = {};
+    session.state = STATE_RUNNING;
+    session.stateBeforePause = STATE_RUNNING;
+    session.duration = 60;
+    session.elapsedMs = 60000;
+    s.timer.restoreSession(session, 0, s.state);
+    s.update();
+    TEST_ASSERT_TRUE_MESSAGE(s.timer.isAlarmActive(), "completion at clock 0 starts the alarm");
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(1000, s.timer.getMsUntilNextEvent(s.state), "00:00 hold before the alarm");
+
+    for (uint8_t i = 0; i < 32 && s.state == STATE_RUNNING; i++) {
+        s.clock.advanceMs(s.timer.getMsUntilNextEvent(s.state));
+        s.update();
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(STATE_SHORT_BREAK, s.state, "alarm ran its course, break started");
+    TEST_ASSERT_FALSE(s.timer.isAlarmActive());
+}
+
+static void checkElapsed(Session& s, uint64_t expectedUs, uint32_t seq, uint32_t op, const char* when) {
+    if (s.timer.getElapsedUs() == expectedUs) return;   // Format a message only on failure
+    char message[96];
+    snprintf(message, sizeof(message), "sequence %lu, toggle %lu: elapsed drifted %s",
+             (unsigned long)seq, (unsigned long)op, when);
+    TEST_ASSERT_EQUAL_UINT64_MESSAGE(expectedUs, s.timer.getElapsedUs(), message);
+}
+
+static void test_random_pause_resume_has_zero_drift() {
+    for (uint32_t seq = 0; seq < SEQUENCES; seq++) {
+        Session s;
+        uint64_t runningUs = 0;
+        s.timer.start(SESSION_S, s.state);
+
+        for (uint32_t op = 0; op < OPERATIONS; op++) {
+            // Zero gaps too: toggling twice at the same instant must not gain or lose time
+            uint32_t gapUs = (nextRandom() % 4 == 0) ? 0 : nextRandom() % MAX_GAP_US;
+            s.clock.advanceUs(gapUs);
+            if (s.state == STATE_RUNNING) runningUs += gapUs;
+            s.update();
+            checkElapsed(s, runningUs, seq, op, "before the toggle");
+
+            if (s.state == STATE_RUNNING) s.timer.pause(s.state);
+            else s.timer.resume(s.state);
+            checkElapsed(s, runningUs, seq, op, "after the toggle");
+        }
+
+        // The countdown agrees with the exact total
+        s.update();
+        uint32_t elapsedS = (uint32_t)(runningUs / 1000000ULL);
+        if (s.state == STATE_RUNNING) {
+            TEST_ASSERT_EQUAL_UINT32(SESSION_S - elapsedS, s.timer.getRemaining());
+        }
+    }
+}
+
+int main() {
+    installHostHal();
+    UNITY_BEGIN();
+    RUN_TEST(test_session_started_at_clock_zero_runs);
+    RUN_TEST(test_session_restored_at_clock_zero_runs);
+    RUN_TEST(test_session_completed_at_clock_zero_alarms);
+    RUN_TEST(test_random_pause_resume_has_zero_drift);
+    return UNITY_END();
+}